@@ -1,6 +1,41 @@
 // Copyright Echo Alchemist Game. All Rights Reserved.
 
 #include "Combat/CircularSceneManager.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	/**
+	 * 4路归一化角度到[0, 2π)
+	 * 使用 x - floor(x / 2π) * 2π，与 NormalizeAngle 的 Fmod 结果一致（仅有舍入误差）
+	 */
+	FORCEINLINE VectorRegister4Float VectorNormalizeAngle(const VectorRegister4Float& Angles)
+	{
+		const VectorRegister4Float TwoPi = VectorSetFloat1(2.0f * PI);
+		const VectorRegister4Float InvTwoPi = VectorSetFloat1(1.0f / (2.0f * PI));
+		
+		VectorRegister4Float Result = VectorNegateMultiplyAdd(VectorFloor(VectorMultiply(Angles, InvTwoPi)), TwoPi, Angles);
+		
+		// 舍入可能得到 2π 或极小的负数，回绕到区间内
+		Result = VectorSelect(VectorCompareGE(Result, TwoPi), VectorSubtract(Result, TwoPi), Result);
+		return VectorMax(Result, VectorZeroFloat());
+	}
+
+	/**
+	 * 加载最多4个角度（不足4个时补0）
+	 */
+	FORCEINLINE VectorRegister4Float LoadAngles(const float* Angles, int32 Count)
+	{
+		if (Count == 4)
+		{
+			return VectorLoad(Angles);
+		}
+		
+		alignas(16) float Padded[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		FMemory::Memcpy(Padded, Angles, Count * sizeof(float));
+		return VectorLoadAligned(Padded);
+	}
+}
 
 UCircularSceneManager::UCircularSceneManager()
 {
@@ -41,6 +76,17 @@ void UCircularSceneManager::Advance(FVector& Position, FVector& Velocity, float
 	Position = RelativePosition + Center;
 }
 
+void UCircularSceneManager::Advance(TArrayView<FVector> Positions, TArrayView<FVector> Velocities, float DeltaTime)
+{
+	check(Positions.Num() == Velocities.Num());
+	
+	// 环形场景没有环境力，直接积分
+	for (int32 i = 0; i < Positions.Num(); ++i)
+	{
+		Positions[i] += Velocities[i] * DeltaTime;
+	}
+}
+
 FVector UCircularSceneManager::GetLaunchVector(const FVector& StartPosition, float TargetAngle)
 {
 	// 转换到相对坐标
@@ -130,6 +176,47 @@ void UCircularSceneManager::HandleBoundaryInteraction(FVector& Position, FVector
 	Position = RelativePosition + Center;
 }
 
+void UCircularSceneManager::HandleBoundaryInteraction(TArrayView<FVector> Positions, TArrayView<FVector> Velocities)
+{
+	check(Positions.Num() == Velocities.Num());
+	
+	const double InnerRadiusSquared = FMath::Square(static_cast<double>(InnerRadius));
+	const double OuterRadiusSquared = FMath::Square(static_cast<double>(OuterRadius));
+	int32 BounceCount = 0;
+	
+	for (int32 i = 0; i < Positions.Num(); ++i)
+	{
+		FVector& Position = Positions[i];
+		const double DX = Position.X - Center.X;
+		const double DY = Position.Y - Center.Y;
+		const double RadiusSquared = DX * DX + DY * DY;
+		
+		// 圆环内：与单个版本一样把位置投影到场景平面
+		if (RadiusSquared <= OuterRadiusSquared && RadiusSquared >= InnerRadiusSquared)
+		{
+			Position.Z = Center.Z;
+			continue;
+		}
+		
+		// 径向单位向量（用相对坐标直接归一化，避免 atan2 + sincos）
+		const double Radius = FMath::Sqrt(RadiusSquared);
+		const FVector Radial = Radius > UE_SMALL_NUMBER ? FVector(DX / Radius, DY / Radius, 0.0) : FVector(1.0, 0.0, 0.0);
+		
+		// 超出外半径时法向量向内，小于内半径时向外
+		const bool bOuter = RadiusSquared > OuterRadiusSquared;
+		const double ClampedRadius = bOuter ? OuterRadius : InnerRadius;
+		
+		Velocities[i] = CalculateBounceVelocity(Velocities[i], bOuter ? -Radial : Radial);
+		ApplyBounceCoefficient(Velocities[i]);
+		
+		Position = FVector(Center.X + Radial.X * ClampedRadius, Center.Y + Radial.Y * ClampedRadius, Center.Z);
+		BounceCount++;
+	}
+	
+	UE_LOG(LogTemp, VeryVerbose, TEXT("CircularSceneManager: Batch boundary handled %d bodies, %d bounced"), 
+		Positions.Num(), BounceCount);
+}
+
 // WorldToScreen 和 ScreenToWorld 已移至基类，使用默认实现
 
 void UCircularSceneManager::CartesianToPolar(const FVector& CartesianPosition, float& OutRadius, float& OutAngle) const
@@ -174,6 +261,63 @@ float UCircularSceneManager::UpdateEnemyAngle(float CurrentAngle, float AngularV
 	return NormalizeAngle(NewAngle);
 }
 
+void UCircularSceneManager::GetEnemyPositions(TConstArrayView<float> Angles, TArrayView<FVector> OutPositions) const
+{
+	check(Angles.Num() == OutPositions.Num());
+	
+	const VectorRegister4Float VRadius = VectorSetFloat1(EnemyRadius);
+	alignas(16) float CosValues[4];
+	alignas(16) float SinValues[4];
+	
+	for (int32 Base = 0; Base < Angles.Num(); Base += 4)
+	{
+		const int32 Count = FMath::Min(4, Angles.Num() - Base);
+		const VectorRegister4Float VAngles = LoadAngles(Angles.GetData() + Base, Count);
+		
+		// sin/cos 是周期函数，不需要先归一化
+		VectorRegister4Float VSin, VCos;
+		VectorSinCos(&VSin, &VCos, &VAngles);
+		VectorStoreAligned(VectorMultiply(VCos, VRadius), CosValues);
+		VectorStoreAligned(VectorMultiply(VSin, VRadius), SinValues);
+		
+		for (int32 Lane = 0; Lane < Count; ++Lane)
+		{
+			OutPositions[Base + Lane] = FVector(Center.X + CosValues[Lane], Center.Y + SinValues[Lane], Center.Z);
+		}
+	}
+}
+
+void UCircularSceneManager::AdvanceEnemyAngles(TArrayView<float> Angles, float AngularVelocity, float DeltaTime, TArrayView<FVector> OutPositions) const
+{
+	check(Angles.Num() == OutPositions.Num());
+	
+	const VectorRegister4Float VStep = VectorSetFloat1(AngularVelocity * DeltaTime);
+	const VectorRegister4Float VRadius = VectorSetFloat1(EnemyRadius);
+	alignas(16) float NewAngles[4];
+	alignas(16) float CosValues[4];
+	alignas(16) float SinValues[4];
+	
+	for (int32 Base = 0; Base < Angles.Num(); Base += 4)
+	{
+		const int32 Count = FMath::Min(4, Angles.Num() - Base);
+		
+		// 推进并归一化角度
+		const VectorRegister4Float VAngles = VectorNormalizeAngle(VectorAdd(LoadAngles(Angles.GetData() + Base, Count), VStep));
+		VectorStoreAligned(VAngles, NewAngles);
+		
+		VectorRegister4Float VSin, VCos;
+		VectorSinCos(&VSin, &VCos, &VAngles);
+		VectorStoreAligned(VectorMultiply(VCos, VRadius), CosValues);
+		VectorStoreAligned(VectorMultiply(VSin, VRadius), SinValues);
+		
+		for (int32 Lane = 0; Lane < Count; ++Lane)
+		{
+			Angles[Base + Lane] = NewAngles[Lane];
+			OutPositions[Base + Lane] = FVector(Center.X + CosValues[Lane], Center.Y + SinValues[Lane], Center.Z);
+		}
+	}
+}
+
 float UCircularSceneManager::NormalizeAngle(float Angle)
 {
 	// 使用 FMath::Fmod 优化角度归一化，替换 while 循环
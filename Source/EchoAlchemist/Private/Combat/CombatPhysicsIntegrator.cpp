@@ -4,6 +4,8 @@
 #include "Physics/MarbleState.h"
 #include "Combat/EnemyData.h"
 #include "Physics/CollisionShape.h"
+#include "Tasks/Task.h"
+#include "Misc/App.h"
 
 UCombatPhysicsIntegrator::UCombatPhysicsIntegrator()
 {
@@ -31,6 +33,10 @@ void UCombatPhysicsIntegrator::Initialize(
 	CollisionBodyToMarbleMap.Empty();
 	CollisionBodyToEnemyMap.Empty();
 	
+	// 清空统计
+	DamageByPotionType.Empty();
+	TotalHitCount = 0;
+	
 	UE_LOG(LogTemp, Log, TEXT("CombatPhysicsIntegrator: Initialized"));
 }
 
@@ -95,6 +101,25 @@ int32 UCombatPhysicsIntegrator::GetMarbleCount() const
 
 void UCombatPhysicsIntegrator::Tick(float DeltaTime)
 {
+	// 敌人由调用方更新时没有可与魔药积分并行的工作，不值得启动任务
+	if (bUseTaskGraph && EnemyManager && bUpdateEnemies && FApp::ShouldUseThreadingForPerformance())
+	{
+		TickTaskGraph(DeltaTime);
+	}
+	else
+	{
+		TickSerial(DeltaTime);
+	}
+}
+
+void UCombatPhysicsIntegrator::TickSerial(float DeltaTime)
+{
+	// 更新敌人（生成队列 + 移动）
+	if (EnemyManager && bUpdateEnemies)
+	{
+		EnemyManager->UpdateEnemies(DeltaTime);
+	}
+	
 	// 更新物理系统
 	UpdatePhysics(DeltaTime);
 	
@@ -102,7 +127,44 @@ void UCombatPhysicsIntegrator::Tick(float DeltaTime)
 	UpdateCollisionBodies();
 	
 	// 检测碰撞
-	DetectCollisions();
+	TArray<FEchoCollisionEvent> Collisions;
+	DetectCollisions(Collisions);
+	
+	// 伤害结算
+	ResolveCollisions(Collisions);
+}
+
+void UCombatPhysicsIntegrator::TickTaskGraph(float DeltaTime)
+{
+	using namespace UE::Tasks;
+	
+	// 阶段0（游戏线程）：生成排队的敌人，会广播事件
+	EnemyManager->ProcessSpawnQueue();
+	
+	// 阶段1a：魔药积分（只写物理系统）
+	FTask IntegrateTask = Launch(UE_SOURCE_LOCATION, [this, DeltaTime]()
+	{
+		UpdatePhysics(DeltaTime);
+	});
+	
+	// 阶段1b：敌人移动（只写敌人列表），与魔药积分并行
+	FTask EnemyMoveTask = Launch(UE_SOURCE_LOCATION, [this, DeltaTime]()
+	{
+		EnemyManager->UpdateEnemyMovement(DeltaTime);
+	});
+	
+	// 阶段2：宽相，两侧位置就绪后开始（只写碰撞管理器和碰撞体映射）
+	TTask<TArray<FEchoCollisionEvent>> BroadphaseTask = Launch(UE_SOURCE_LOCATION, [this]()
+	{
+		UpdateCollisionBodies();
+		
+		TArray<FEchoCollisionEvent> Collisions;
+		DetectCollisions(Collisions);
+		return Collisions;
+	}, Prerequisites(IntegrateTask, EnemyMoveTask));
+	
+	// 阶段3（游戏线程）：汇合后进行伤害结算
+	ResolveCollisions(BroadphaseTask.GetResult());
 }
 
 void UCombatPhysicsIntegrator::HandleCollision(const FEchoCollisionEvent& CollisionEvent)
@@ -187,15 +249,24 @@ void UCombatPhysicsIntegrator::UpdateCollisionBodies()
 	CollisionManager->UpdateSpatialGrid();
 }
 
-void UCombatPhysicsIntegrator::DetectCollisions()
+void UCombatPhysicsIntegrator::DetectCollisions(TArray<FEchoCollisionEvent>& OutCollisions)
 {
 	if (!CollisionManager)
 	{
+		OutCollisions.Reset();
 		return;
 	}
 	
-	// 检测碰撞
-	TArray<FEchoCollisionEvent> Collisions = CollisionManager->DetectCollisions();
+	// 检测碰撞（事件在伤害结算阶段补发）
+	CollisionManager->DetectCollisionsDeferred(OutCollisions);
+}
+
+void UCombatPhysicsIntegrator::ResolveCollisions(const TArray<FEchoCollisionEvent>& Collisions)
+{
+	if (CollisionManager)
+	{
+		CollisionManager->BroadcastCollisionEvents(Collisions);
+	}
 	
 	// 处理每个碰撞事件
 	for (const FEchoCollisionEvent& Collision : Collisions)
@@ -225,6 +296,10 @@ void UCombatPhysicsIntegrator::HandleMarbleEnemyCollision(FGuid MarbleID, FGuid
 	// 应用伤害到敌人
 	bool bDied = EnemyManager->ApplyDamageToEnemy(EnemyID, DamageInfo.FinalDamage);
 	
+	// 记录统计
+	DamageByPotionType.FindOrAdd(MarbleState.PotionType) += DamageInfo.FinalDamage;
+	TotalHitCount++;
+	
 	UE_LOG(LogTemp, Log, TEXT("CombatPhysicsIntegrator: Marble %s hit enemy %s for %.1f damage. Enemy %s"),
 		*MarbleID.ToString(), *EnemyID.ToString(), DamageInfo.FinalDamage, bDied ? TEXT("died") : TEXT("survived"));
 	
@@ -0,0 +1,243 @@
+// Copyright Echo Alchemist Game. All Rights Reserved.
+
+#include "Combat/CombatSimulator.h"
+#include "Combat/CombatSystemInitializer.h"
+#include "Combat/CombatManager.h"
+#include "Combat/CombatPhysicsIntegrator.h"
+#include "Combat/EnemyManager.h"
+#include "Physics/MarblePhysicsSystem.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/Package.h"
+
+FCombatSimulationResult UCombatSimulator::SimulateCombat(const FCombatSimulationParams& Params)
+{
+	TArray<FCombatSimulationResult> Results;
+	SimulateCombatBatch(Params, 1, Results);
+
+	return Results.Num() > 0 ? Results[0] : FCombatSimulationResult();
+}
+
+FCombatSimulationStats UCombatSimulator::SimulateCombatBatch(const FCombatSimulationParams& Params, int32 RunCount, TArray<FCombatSimulationResult>& OutResults)
+{
+	check(IsInGameThread());
+
+	OutResults.Reset();
+	if (RunCount <= 0)
+	{
+		return FCombatSimulationStats();
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// 屏蔽战斗栈中的逐帧日志（退出时恢复）
+	const ELogVerbosity::Type PreviousVerbosity = LogTemp.GetVerbosity();
+	if (Params.bSuppressLogging)
+	{
+		LogTemp.SetVerbosity(ELogVerbosity::Warning);
+	}
+	ON_SCOPE_EXIT
+	{
+		LogTemp.SetVerbosity(PreviousVerbosity);
+	};
+
+	OutResults.SetNum(RunCount);
+
+	// 分批创建战斗栈，避免一次性创建数千个对象
+	const int32 BatchSize = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() * 4);
+	TArray<UCombatManager*> Batch;
+	Batch.Reserve(BatchSize);
+
+	for (int32 BatchStart = 0; BatchStart < RunCount; BatchStart += BatchSize)
+	{
+		const int32 BatchCount = FMath::Min(BatchSize, RunCount - BatchStart);
+
+		// 游戏线程：创建对象
+		Batch.Reset();
+		for (int32 i = 0; i < BatchCount; ++i)
+		{
+			Batch.Add(CreateCombat(Params));
+		}
+
+		// 工作线程：每场战斗只访问自己的战斗栈
+		ParallelFor(BatchCount, [&Batch, &OutResults, &Params, BatchStart](int32 i)
+		{
+			const int32 RunIndex = BatchStart + i;
+			const int32 Seed = Params.RandomSeed + RunIndex;
+
+			if (Batch[i])
+			{
+				OutResults[RunIndex] = RunCombat(Batch[i], Params, Seed);
+			}
+			else
+			{
+				OutResults[RunIndex].Seed = Seed;
+			}
+		});
+	}
+
+	FCombatSimulationStats Stats = AggregateResults(OutResults);
+	Stats.WallClockSeconds = static_cast<float>(FPlatformTime::Seconds() - StartTime);
+
+	UE_LOG(LogTemp, Display, TEXT("CombatSimulator: %d runs (%.0f simulated seconds) in %.2fs, win rate %.1f%%"),
+		Stats.RunCount, Stats.TotalSimulatedSeconds, Stats.WallClockSeconds, Stats.WinRate * 100.0f);
+
+	return Stats;
+}
+
+FCombatSimulationStats UCombatSimulator::AggregateResults(const TArray<FCombatSimulationResult>& Results)
+{
+	FCombatSimulationStats Stats;
+	Stats.RunCount = Results.Num();
+	if (Results.Num() == 0)
+	{
+		return Stats;
+	}
+
+	int64 TotalKills = 0;
+	double TotalVictoryTime = 0.0;
+	Stats.MinTimeToVictory = FLT_MAX;
+
+	for (const FCombatSimulationResult& Result : Results)
+	{
+		TotalKills += Result.Kills;
+		Stats.TotalSimulatedSeconds += Result.CombatTime;
+
+		if (Result.bVictory)
+		{
+			Stats.VictoryCount++;
+			TotalVictoryTime += Result.CombatTime;
+			Stats.MinTimeToVictory = FMath::Min(Stats.MinTimeToVictory, Result.CombatTime);
+			Stats.MaxTimeToVictory = FMath::Max(Stats.MaxTimeToVictory, Result.CombatTime);
+		}
+
+		for (const TPair<EPotionType, float>& Pair : Result.DamageByPotionType)
+		{
+			Stats.AverageDamageByPotionType.FindOrAdd(Pair.Key) += Pair.Value;
+		}
+	}
+
+	Stats.WinRate = static_cast<float>(Stats.VictoryCount) / Stats.RunCount;
+	Stats.AverageKills = static_cast<float>(TotalKills) / Stats.RunCount;
+
+	if (Stats.VictoryCount > 0)
+	{
+		Stats.AverageTimeToVictory = static_cast<float>(TotalVictoryTime / Stats.VictoryCount);
+	}
+	else
+	{
+		Stats.MinTimeToVictory = 0.0f;
+	}
+
+	for (TPair<EPotionType, float>& Pair : Stats.AverageDamageByPotionType)
+	{
+		Pair.Value /= Stats.RunCount;
+	}
+
+	return Stats;
+}
+
+UCombatManager* UCombatSimulator::CreateCombat(const FCombatSimulationParams& Params)
+{
+	UCombatManager* CombatManager = UCombatSystemInitializer::InitializeCombatSystemWithConfig(
+		GetTransientPackage(), Params.Config, Params.SceneType);
+	if (!CombatManager)
+	{
+		return nullptr;
+	}
+
+	// 并行度来自多场战斗，单场内部串行更新；敌人由集成器每帧更新
+	CombatManager->GetPhysicsIntegrator()->SetUseTaskGraph(false);
+	CombatManager->GetPhysicsIntegrator()->SetUpdateEnemies(true);
+	CombatManager->StartCombat();
+
+	return CombatManager;
+}
+
+FCombatSimulationResult UCombatSimulator::RunCombat(UCombatManager* CombatManager, const FCombatSimulationParams& Params, int32 Seed)
+{
+	FCombatSimulationResult Result;
+	Result.Seed = Seed;
+
+	UCombatPhysicsIntegrator* Integrator = CombatManager->GetPhysicsIntegrator();
+	UEnemyManager* EnemyManager = Integrator->GetEnemyManager();
+	const FCombatConfig& Config = Params.Config;
+	const bool bCircular = Params.SceneType == ECombatSceneType::Circular;
+
+	FRandomStream Stream(Seed);
+	const float EnemyHealth = Params.EnemyMaxHealth * Config.EnemyHealthMultiplier;
+	const float SpawnInterval = Config.EnemySpawnInterval / FMath::Max(Config.EnemySpawnRateMultiplier, KINDA_SMALL_NUMBER);
+
+	// 敌人位置来自本场的随机流，保证同一种子的生成位置一致
+	auto SpawnEnemy = [&]()
+	{
+		if (bCircular)
+		{
+			EnemyManager->SpawnEnemyAtAngle(Params.EnemyType, Stream.FRandRange(0.0f, 2.0f * PI), EnemyHealth);
+		}
+		else
+		{
+			const FVector Position(Stream.FRandRange(-500.0f, 500.0f), Stream.FRandRange(-500.0f, 500.0f), 0.0f);
+			EnemyManager->SpawnEnemy(Params.EnemyType, Position, EnemyHealth);
+		}
+	};
+
+	for (int32 i = 0; i < Config.InitialEnemyCount; ++i)
+	{
+		SpawnEnemy();
+	}
+
+	FMarbleLaunchParams LaunchParams;
+	LaunchParams.LaunchPosition = Params.LaunchPosition;
+	LaunchParams.LaunchSpeed = Params.LaunchSpeed;
+	LaunchParams.PotencyMultiplier = Params.PotencyMultiplier;
+
+	const float TimeStep = FMath::Max(Params.TimeStep, 0.001f);
+	const int32 MaxSteps = FMath::CeilToInt32(Params.DurationSeconds / TimeStep);
+	float SpawnTimer = 0.0f;
+	float LaunchTimer = Params.LaunchInterval;
+
+	for (int32 Step = 0; Step < MaxSteps && CombatManager->IsInCombat(); ++Step)
+	{
+		// 补充敌人
+		SpawnTimer += TimeStep;
+		if (SpawnTimer >= SpawnInterval)
+		{
+			SpawnTimer -= SpawnInterval;
+			if (EnemyManager->GetAliveEnemyCount() < Config.MaxEnemies)
+			{
+				SpawnEnemy();
+			}
+		}
+
+		// 向最近的敌人发射魔药
+		LaunchTimer += TimeStep;
+		if (LaunchTimer >= Params.LaunchInterval && Integrator->GetMarbleCount() < Params.MaxActiveMarbles)
+		{
+			FEnemyData Target;
+			if (EnemyManager->GetNearestEnemy(Params.LaunchPosition, Target))
+			{
+				LaunchTimer = 0.0f;
+				LaunchParams.LaunchDirection = Target.Position - Params.LaunchPosition;
+				LaunchParams.PotionType = Params.PotionLoadout.Num() > 0
+					? Params.PotionLoadout[Result.MarblesLaunched % Params.PotionLoadout.Num()]
+					: EPotionType::Ricochet;
+
+				CombatManager->LaunchMarble(LaunchParams);
+				Result.MarblesLaunched++;
+			}
+		}
+
+		CombatManager->Tick(TimeStep);
+		EnemyManager->RemoveDeadEnemies();
+	}
+
+	Result.Kills = CombatManager->GetKillCount();
+	Result.bVictory = Result.Kills >= Config.VictoryKillCount;
+	Result.CombatTime = CombatManager->GetCombatTime();
+	Result.Hits = Integrator->GetTotalHitCount();
+	Result.DamageByPotionType = Integrator->GetDamageByPotionType();
+
+	return Result;
+}
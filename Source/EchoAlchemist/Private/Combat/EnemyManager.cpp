@@ -2,18 +2,44 @@
 
 #include "Combat/EnemyManager.h"
 #include "Combat/CircularSceneManager.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	/** 把角度字段同步到 ExtraData["Angle"]（只在复制给外部读取者时调用，移动时不做字符串转换） */
+	FEnemyData& SyncAngleExtraData(FEnemyData& Enemy)
+	{
+		if (FString* AngleStr = Enemy.ExtraData.Find(TEXT("Angle")))
+		{
+			*AngleStr = FString::SanitizeFloat(Enemy.Angle);
+		}
+		return Enemy;
+	}
+}
 
 UEnemyManager::UEnemyManager()
 {
 	EnemyMoveSpeed = 100.0f;
 	EnemyAngularVelocity = 0.5f;
 	EnemyAttackInterval = 2.0f;
+	DefaultWaveSpawnFrames = 4;
+	
+	BuildDefaultEnemyTemplates();
 }
 
 void UEnemyManager::Initialize(TScriptInterface<ISceneManager> InSceneManager)
 {
 	SceneManager = InSceneManager;
 	Enemies.Empty();
+	PendingWaves.Empty();
+	NextWaveID = 0;
+	
+	// 每次初始化重新生成池化ID基础值
+	PooledIDBase = FGuid::NewGuid();
+	PooledIDSerial = 0;
+	
+	SpatialIndex.Reset();
+	bSpatialIndexDirty = true;
 	
 	UE_LOG(LogTemp, Log, TEXT("EnemyManager: Initialized with scene type: %s"), 
 		SceneManager.GetInterface() ? *SceneManager->GetSceneType() : TEXT("None"));
@@ -21,46 +47,23 @@ void UEnemyManager::Initialize(TScriptInterface<ISceneManager> InSceneManager)
 
 FGuid UEnemyManager::SpawnEnemy(EEnemyType EnemyType, FVector Position, float MaxHealth)
 {
-	// 创建敌人数据
-	FEnemyData Enemy;
-	Enemy.ID = FGuid::NewGuid();
-	Enemy.EnemyType = EnemyType;
-	Enemy.Position = Position;
-	Enemy.Health = MaxHealth;
-	Enemy.MaxHealth = MaxHealth;
-	Enemy.State = EEnemyState::Idle;
-	Enemy.bIsActive = true;
+	// 从对象池取出槽位并按模板初始化（名称、碰撞、属性表来自模板）
+	const FEnemyData& Enemy = AcquireEnemy(EnemyType, Position, MaxHealth);
+	const FGuid EnemyID = Enemy.ID;
 	
-	// 根据敌人类型设置名称
-	switch (EnemyType)
-	{
-	case EEnemyType::CrystalGolem:
-		Enemy.Name = TEXT("Crystal Golem");
-		break;
-	case EEnemyType::EliteGolem:
-		Enemy.Name = TEXT("Elite Golem");
-		break;
-	case EEnemyType::BossGolem:
-		Enemy.Name = TEXT("Boss Golem");
-		break;
-	}
-	
-	// 添加到敌人列表
-	Enemies.Add(Enemy);
+	UE_LOG(LogTemp, Log, TEXT("EnemyManager: Spawned enemy %s at (%.1f, %.1f, %.1f)"), 
+		*Enemy.Name, Position.X, Position.Y, Position.Z);
 	
-	// 发布敌人生成事件
+	// 发布敌人生成事件（监听者可能继续生成敌人，之后不再访问Enemy引用）
 	FCombatEvent Event;
 	Event.EventType = ECombatEventType::EnemySpawned;
 	Event.Timestamp = FPlatformTime::Seconds();
-	Event.EntityID = Enemy.ID;
+	Event.EntityID = EnemyID;
 	Event.ExtraData.Add(TEXT("EnemyType"), static_cast<float>(EnemyType));
 	Event.ExtraData.Add(TEXT("MaxHealth"), MaxHealth);
 	BroadcastEnemyEvent(Event);
 	
-	UE_LOG(LogTemp, Log, TEXT("EnemyManager: Spawned enemy %s at (%.1f, %.1f, %.1f)"), 
-		*Enemy.Name, Position.X, Position.Y, Position.Z);
-	
-	return Enemy.ID;
+	return EnemyID;
 }
 
 FGuid UEnemyManager::SpawnEnemyAtAngle(EEnemyType EnemyType, float Angle, float MaxHealth)
@@ -88,6 +91,7 @@ FGuid UEnemyManager::SpawnEnemyAtAngle(EEnemyType EnemyType, float Angle, float
 				int32 Index = FindEnemyIndex(EnemyID);
 				if (Index != INDEX_NONE)
 				{
+					Enemies[Index].Angle = Angle;
 					Enemies[Index].ExtraData.Add(TEXT("Angle"), FString::SanitizeFloat(Angle));
 			}
 			
@@ -144,16 +148,193 @@ TArray<FGuid> UEnemyManager::SpawnEnemies(EEnemyType EnemyType, int32 Count, flo
 	return EnemyIDs;
 }
 
+int32 UEnemyManager::QueueWave(EEnemyType EnemyType, int32 Count, float MaxHealth, int32 SpreadFrames)
+{
+	if (!SceneManager.GetInterface())
+	{
+		UE_LOG(LogTemp, Error, TEXT("EnemyManager: Scene manager not set"));
+		return 0;
+	}
+	
+	if (Count <= 0)
+	{
+		return 0;
+	}
+	
+	FPendingEnemyWave& Wave = PendingWaves.AddDefaulted_GetRef();
+	Wave.WaveID = ++NextWaveID;
+	Wave.EnemyType = EnemyType;
+	Wave.MaxHealth = MaxHealth;
+	Wave.TotalCount = Count;
+	Wave.SpawnedCount = 0;
+	Wave.FramesLeft = SpreadFrames > 0 ? SpreadFrames : FMath::Max(1, DefaultWaveSpawnFrames);
+	
+	// 一次性预留整个波次的空间，分帧生成时不再扩容
+	Enemies.Reserve(Enemies.Num() + GetPendingSpawnCount());
+	
+	UE_LOG(LogTemp, Log, TEXT("EnemyManager: Queued wave of %d enemies over %d frames"), Count, Wave.FramesLeft);
+	
+	return Count;
+}
+
+int32 UEnemyManager::ProcessSpawnQueue()
+{
+	if (PendingWaves.Num() == 0 || !SceneManager.GetInterface())
+	{
+		return 0;
+	}
+	
+	// 场景类型每帧只判断一次
+	const UCircularSceneManager* CircularScene = nullptr;
+	if (SceneManager->GetSceneType() == TEXT("Circular"))
+	{
+		CircularScene = Cast<UCircularSceneManager>(SceneManager.GetObject());
+	}
+	
+	int32 SpawnedThisFrame = 0;
+	
+	// 按索引遍历：事件监听者可能在回调中加入新波次
+	for (int32 WaveIndex = 0; WaveIndex < PendingWaves.Num(); ++WaveIndex)
+	{
+		const FPendingEnemyWave Wave = PendingWaves[WaveIndex];
+		
+		// 本帧配额：剩余数量平均分摊到剩余帧
+		const int32 Remaining = Wave.TotalCount - Wave.SpawnedCount;
+		const int32 Quota = FMath::DivideAndRoundUp(Remaining, FMath::Max(Wave.FramesLeft, 1));
+		
+		int32 Spawned = 0;
+		bool bWaveRemoved = false;
+		for (int32 i = 0; i < Quota; ++i)
+		{
+			float Angle = 0.0f;
+			const FVector Position = GetWaveSpawnPosition(Wave.SpawnedCount + i, Wave.TotalCount, CircularScene, Angle);
+			FEnemyData& Enemy = AcquireEnemy(Wave.EnemyType, Position, Wave.MaxHealth);
+			
+			if (CircularScene)
+			{
+				Enemy.Angle = Angle;
+				Enemy.ExtraData.Add(TEXT("Angle"), FString::SanitizeFloat(Angle));
+			}
+			
+			// 只有存在监听者时才构建事件
+			if (OnEnemyEvent.IsBound())
+			{
+				FCombatEvent Event;
+				Event.EventType = ECombatEventType::EnemySpawned;
+				Event.Timestamp = FPlatformTime::Seconds();
+				Event.EntityID = Enemy.ID;
+				Event.ExtraData.Add(TEXT("EnemyType"), static_cast<float>(Wave.EnemyType));
+				Event.ExtraData.Add(TEXT("MaxHealth"), Wave.MaxHealth);
+				BroadcastEnemyEvent(Event);
+			}
+			Spawned++;
+			
+			// 监听者可能在回调中清空队列（例如 ClearAllEnemies），此时停止生成这个波次
+			if (!PendingWaves.IsValidIndex(WaveIndex) || PendingWaves[WaveIndex].WaveID != Wave.WaveID)
+			{
+				bWaveRemoved = true;
+				break;
+			}
+		}
+		
+		SpawnedThisFrame += Spawned;
+		
+		if (bWaveRemoved)
+		{
+			// 队列已被改动，剩余波次留到下一帧（下标不再可靠）
+			break;
+		}
+		
+		PendingWaves[WaveIndex].SpawnedCount += Spawned;
+		PendingWaves[WaveIndex].FramesLeft = FMath::Max(Wave.FramesLeft - 1, 1);
+	}
+	
+	// 移除已完成的波次
+	PendingWaves.RemoveAll([](const FPendingEnemyWave& Wave)
+	{
+		return Wave.SpawnedCount >= Wave.TotalCount;
+	});
+	
+	UE_LOG(LogTemp, Verbose, TEXT("EnemyManager: Spawned %d queued enemies this frame, %d pending"), 
+		SpawnedThisFrame, GetPendingSpawnCount());
+	
+	return SpawnedThisFrame;
+}
+
+int32 UEnemyManager::GetPendingSpawnCount() const
+{
+	int32 Count = 0;
+	
+	for (const FPendingEnemyWave& Wave : PendingWaves)
+	{
+		Count += Wave.TotalCount - Wave.SpawnedCount;
+	}
+	
+	return Count;
+}
+
+void UEnemyManager::ReserveEnemyPool(int32 Capacity)
+{
+	Enemies.Reserve(Capacity);
+	EnemyPool.Reserve(Capacity);
+	
+	// 预先创建池化数据，生成时只需拷贝模板
+	const FEnemyData* Template = EnemyTemplates.Find(EEnemyType::CrystalGolem);
+	while (Enemies.Num() + EnemyPool.Num() < Capacity)
+	{
+		EnemyPool.Add(Template ? *Template : FEnemyData());
+	}
+}
+
+void UEnemyManager::SetEnemyTemplate(EEnemyType EnemyType, const FEnemyData& Template)
+{
+	FEnemyData& Stored = EnemyTemplates.Add(EnemyType, Template);
+	Stored.EnemyType = EnemyType;
+}
+
 void UEnemyManager::UpdateEnemies(float DeltaTime)
 {
-	// 更新所有敌人
-	for (FEnemyData& Enemy : Enemies)
+	// 先生成本帧配额内的排队敌人
+	ProcessSpawnQueue();
+	
+	UpdateEnemyMovement(DeltaTime);
+}
+
+void UEnemyManager::UpdateEnemyMovement(float DeltaTime)
+{
+	const UCircularSceneManager* CircularScene = nullptr;
+	if (SceneManager.GetInterface() && SceneManager->GetSceneType() == TEXT("Circular"))
 	{
-		if (Enemy.bIsActive)
+		CircularScene = Cast<UCircularSceneManager>(SceneManager.GetObject());
+	}
+	
+	if (CircularScene)
+	{
+		// 环形场景：批量推进所有敌人的角度，再逐个更新攻击
+		UpdateEnemyMovementCircularBatch(CircularScene, DeltaTime);
+		
+		for (FEnemyData& Enemy : Enemies)
 		{
-			UpdateEnemy(Enemy, DeltaTime);
+			if (Enemy.bIsActive)
+			{
+				UpdateEnemyAttack(Enemy, DeltaTime);
+			}
 		}
 	}
+	else
+	{
+		// 更新所有敌人
+		for (FEnemyData& Enemy : Enemies)
+		{
+			if (Enemy.bIsActive)
+			{
+				UpdateEnemy(Enemy, DeltaTime);
+			}
+		}
+	}
+	
+	// 位置已变化，空间索引在下次查询时重建
+	bSpatialIndexDirty = true;
 }
 
 void UEnemyManager::UpdateEnemy(FEnemyData& Enemy, float DeltaTime)
@@ -193,6 +374,10 @@ bool UEnemyManager::ApplyDamageToEnemy(FGuid EnemyID, float Damage)
 	
 	// 应用伤害
 	bool bDied = Enemy.ApplyDamage(Damage);
+	if (bDied)
+	{
+		bSpatialIndexDirty = true;
+	}
 	
 	// 发布敌人受伤事件
 	FCombatEvent Event;
@@ -217,7 +402,9 @@ bool UEnemyManager::RemoveEnemy(FGuid EnemyID)
 		return false;
 	}
 	
+	ReleaseEnemy(MoveTemp(Enemies[Index]));
 	Enemies.RemoveAt(Index);
+	bSpatialIndexDirty = true;
 	
 	UE_LOG(LogTemp, Log, TEXT("EnemyManager: Removed enemy: %s"), *EnemyID.ToString());
 	
@@ -226,17 +413,29 @@ bool UEnemyManager::RemoveEnemy(FGuid EnemyID)
 
 int32 UEnemyManager::RemoveDeadEnemies()
 {
-	int32 RemovedCount = 0;
+	// 单遍压缩：存活敌人保持原有顺序前移，死亡敌人回收到对象池
+	int32 WriteIndex = 0;
 	
-	for (int32 i = Enemies.Num() - 1; i >= 0; --i)
+	for (int32 ReadIndex = 0; ReadIndex < Enemies.Num(); ++ReadIndex)
 	{
-		if (!Enemies[i].IsAlive())
+		if (Enemies[ReadIndex].IsAlive())
+		{
+			if (WriteIndex != ReadIndex)
+			{
+				Enemies[WriteIndex] = MoveTemp(Enemies[ReadIndex]);
+			}
+			WriteIndex++;
+		}
+		else
 		{
-			Enemies.RemoveAt(i);
-			RemovedCount++;
+			ReleaseEnemy(MoveTemp(Enemies[ReadIndex]));
 		}
 	}
 	
+	const int32 RemovedCount = Enemies.Num() - WriteIndex;
+	Enemies.SetNum(WriteIndex, EAllowShrinking::No);
+	bSpatialIndexDirty |= RemovedCount > 0;
+	
 	if (RemovedCount > 0)
 	{
 		UE_LOG(LogTemp, Log, TEXT("EnemyManager: Removed %d dead enemies"), RemovedCount);
@@ -247,7 +446,13 @@ int32 UEnemyManager::RemoveDeadEnemies()
 
 void UEnemyManager::ClearAllEnemies()
 {
-	Enemies.Empty();
+	for (FEnemyData& Enemy : Enemies)
+	{
+		ReleaseEnemy(MoveTemp(Enemy));
+	}
+	Enemies.Reset();
+	PendingWaves.Empty();
+	bSpatialIndexDirty = true;
 	
 	UE_LOG(LogTemp, Log, TEXT("EnemyManager: Cleared all enemies"));
 }
@@ -261,6 +466,7 @@ bool UEnemyManager::FindEnemy(FGuid EnemyID, FEnemyData& OutEnemy) const
 	}
 	
 	OutEnemy = Enemies[Index];
+	SyncAngleExtraData(OutEnemy);
 	return true;
 }
 
@@ -272,7 +478,7 @@ TArray<FEnemyData> UEnemyManager::GetAliveEnemies() const
 	{
 		if (Enemy.IsAlive())
 		{
-			AliveEnemies.Add(Enemy);
+			SyncAngleExtraData(AliveEnemies.Add_GetRef(Enemy));
 		}
 	}
 	
@@ -296,29 +502,109 @@ int32 UEnemyManager::GetAliveEnemyCount() const
 
 bool UEnemyManager::GetNearestEnemy(const FVector& Position, FEnemyData& OutEnemy) const
 {
-	float MinDistance = FLT_MAX;
-	int32 NearestIndex = INDEX_NONE;
+	TArray<int32> Indices;
+	if (QueryNearestEnemies(Position, 1, 0.0f, Indices) > 0)
+	{
+		OutEnemy = Enemies[Indices[0]];
+		SyncAngleExtraData(OutEnemy);
+		return true;
+	}
 	
-	for (int32 i = 0; i < Enemies.Num(); ++i)
+	return false;
+}
+
+TArray<FEnemyData> UEnemyManager::GetEnemiesInRadius(const FVector& Position, float Radius) const
+{
+	TArray<FEnemyData> Result;
+	TArray<int32> Indices;
+	QueryEnemiesInRadius(Position, Radius, Indices);
+	
+	Result.Reserve(Indices.Num());
+	for (int32 Index : Indices)
 	{
-		if (Enemies[i].IsAlive())
-		{
-			float Distance = FVector::Dist(Position, Enemies[i].Position);
-			if (Distance < MinDistance)
-			{
-				MinDistance = Distance;
-				NearestIndex = i;
-			}
-		}
+		SyncAngleExtraData(Result.Add_GetRef(Enemies[Index]));
 	}
 	
-	if (NearestIndex != INDEX_NONE)
+	return Result;
+}
+
+TArray<FEnemyData> UEnemyManager::GetNearestEnemies(const FVector& Position, int32 Count, float MaxRadius) const
+{
+	TArray<FEnemyData> Result;
+	TArray<int32> Indices;
+	QueryNearestEnemies(Position, Count, MaxRadius, Indices);
+	
+	Result.Reserve(Indices.Num());
+	for (int32 Index : Indices)
 	{
-		OutEnemy = Enemies[NearestIndex];
-		return true;
+		SyncAngleExtraData(Result.Add_GetRef(Enemies[Index]));
 	}
 	
-	return false;
+	return Result;
+}
+
+int32 UEnemyManager::QueryEnemiesInRadius(const FVector& Position, float Radius, TArray<int32>& OutIndices) const
+{
+	EnsureSpatialIndex();
+	return SpatialIndex.QueryRadius(Position, Radius, OutIndices);
+}
+
+int32 UEnemyManager::QueryNearestEnemies(const FVector& Position, int32 K, float MaxRadius, TArray<int32>& OutIndices) const
+{
+	EnsureSpatialIndex();
+	return SpatialIndex.QueryKNearest(Position, K, MaxRadius, OutIndices);
+}
+
+void UEnemyManager::RebuildSpatialIndex()
+{
+	bSpatialIndexDirty = true;
+	EnsureSpatialIndex();
+}
+
+void UEnemyManager::EnsureSpatialIndex() const
+{
+	FScopeLock Lock(&SpatialIndexLock);
+	if (!bSpatialIndexDirty)
+	{
+		return;
+	}
+	
+	const UCircularSceneManager* CircularScene = nullptr;
+	if (SceneManager.GetInterface() && SceneManager->GetSceneType() == TEXT("Circular"))
+	{
+		CircularScene = Cast<UCircularSceneManager>(SceneManager.GetObject());
+	}
+	
+	// 环形场景按极角分扇区，其余场景使用网格
+	if (CircularScene)
+	{
+		SpatialIndex.BeginAngular(CircularScene->GetCenter(), SpatialIndexAngularBuckets);
+	}
+	else
+	{
+		SpatialIndex.BeginGrid(SpatialIndexCellSize);
+	}
+	
+	// 只索引存活的敌人
+	for (int32 i = 0; i < Enemies.Num(); ++i)
+	{
+		const FEnemyData& Enemy = Enemies[i];
+		if (!Enemy.IsAlive())
+		{
+			continue;
+		}
+		
+		float Angle = 0.0f;
+		if (CircularScene)
+		{
+			float Radius = 0.0f;
+			CircularScene->CartesianToPolar(Enemy.Position - CircularScene->GetCenter(), Radius, Angle);
+		}
+		SpatialIndex.Add(i, Enemy.Position, Angle);
+	}
+	
+	SpatialIndex.Finalize();
+	bSpatialIndexDirty = false;
 }
 
 void UEnemyManager::BroadcastEnemyEvent(const FCombatEvent& Event)
@@ -343,18 +629,45 @@ void UEnemyManager::UpdateEnemyMovementCircular(FEnemyData& Enemy, float DeltaTi
 		return;
 	}
 	
-	// 获取当前角度
-	FString AngleStr = Enemy.ExtraData.FindRef(TEXT("Angle"));
-	float CurrentAngle = FCString::Atof(*AngleStr);
-	
 	// 更新角度
-	float NewAngle = CircularScene->UpdateEnemyAngle(CurrentAngle, EnemyAngularVelocity, DeltaTime);
+	Enemy.Angle = CircularScene->UpdateEnemyAngle(Enemy.Angle, EnemyAngularVelocity, DeltaTime);
 	
 	// 更新位置
-	Enemy.Position = CircularScene->GetEnemyPosition(NewAngle);
+	Enemy.Position = CircularScene->GetEnemyPosition(Enemy.Angle);
+}
+
+void UEnemyManager::UpdateEnemyMovementCircularBatch(const UCircularSceneManager* CircularScene, float DeltaTime)
+{
+	// 收集活跃敌人的角度
+	MovementIndices.Reset();
+	MovementAngles.Reset();
+	
+	for (int32 i = 0; i < Enemies.Num(); ++i)
+	{
+		const FEnemyData& Enemy = Enemies[i];
+		if (Enemy.bIsActive)
+		{
+			MovementIndices.Add(i);
+			MovementAngles.Add(Enemy.Angle);
+		}
+	}
 	
-	// 存储新角度
-	Enemy.ExtraData.Add(TEXT("Angle"), FString::SanitizeFloat(NewAngle));
+	if (MovementIndices.Num() == 0)
+	{
+		return;
+	}
+	
+	// 批量推进角度并计算位置
+	MovementPositions.SetNumUninitialized(MovementIndices.Num(), EAllowShrinking::No);
+	CircularScene->AdvanceEnemyAngles(MovementAngles, EnemyAngularVelocity, DeltaTime, MovementPositions);
+	
+	// 写回
+	for (int32 i = 0; i < MovementIndices.Num(); ++i)
+	{
+		FEnemyData& Enemy = Enemies[MovementIndices[i]];
+		Enemy.Position = MovementPositions[i];
+		Enemy.Angle = MovementAngles[i];
+	}
 }
 
 void UEnemyManager::UpdateEnemyAttack(FEnemyData& Enemy, float DeltaTime)
@@ -375,3 +688,88 @@ int32 UEnemyManager::FindEnemyIndex(FGuid EnemyID) const
 	
 	return INDEX_NONE;
 }
+
+FEnemyData& UEnemyManager::AcquireEnemy(EEnemyType EnemyType, const FVector& Position, float MaxHealth)
+{
+	const FEnemyData* Template = EnemyTemplates.Find(EnemyType);
+	
+	// 优先复用对象池中的槽位（属性表的内存随之复用）
+	FEnemyData& Enemy = EnemyPool.Num() > 0
+		? Enemies.Add_GetRef(EnemyPool.Pop(EAllowShrinking::No))
+		: Enemies.Add_GetRef(Template ? *Template : FEnemyData());
+	
+	if (Template)
+	{
+		Enemy = *Template;
+	}
+	
+	bSpatialIndexDirty = true;
+	
+	// 覆盖每个敌人独有的状态
+	Enemy.ID = MakePooledID();
+	Enemy.EnemyType = EnemyType;
+	Enemy.Position = Position;
+	Enemy.Velocity = FVector::ZeroVector;
+	Enemy.Angle = 0.0f;
+	Enemy.Health = MaxHealth;
+	Enemy.MaxHealth = MaxHealth;
+	Enemy.State = EEnemyState::Idle;
+	Enemy.bIsActive = true;
+	
+	return Enemy;
+}
+
+void UEnemyManager::ReleaseEnemy(FEnemyData&& Enemy)
+{
+	Enemy.bIsActive = false;
+	EnemyPool.Add(MoveTemp(Enemy));
+}
+
+FGuid UEnemyManager::MakePooledID()
+{
+	if (!PooledIDBase.IsValid())
+	{
+		PooledIDBase = FGuid::NewGuid();
+	}
+	
+	// 基础值只生成一次，后续只递增序号
+	return FGuid(PooledIDBase.A, PooledIDBase.B, PooledIDBase.C, ++PooledIDSerial);
+}
+
+void UEnemyManager::BuildDefaultEnemyTemplates()
+{
+	EnemyTemplates.Empty();
+	
+	FEnemyData CrystalGolem;
+	CrystalGolem.EnemyType = EEnemyType::CrystalGolem;
+	CrystalGolem.Name = TEXT("Crystal Golem");
+	EnemyTemplates.Add(EEnemyType::CrystalGolem, CrystalGolem);
+	
+	FEnemyData EliteGolem;
+	EliteGolem.EnemyType = EEnemyType::EliteGolem;
+	EliteGolem.Name = TEXT("Elite Golem");
+	EnemyTemplates.Add(EEnemyType::EliteGolem, EliteGolem);
+	
+	FEnemyData BossGolem;
+	BossGolem.EnemyType = EEnemyType::BossGolem;
+	BossGolem.Name = TEXT("Boss Golem");
+	EnemyTemplates.Add(EEnemyType::BossGolem, BossGolem);
+}
+
+FVector UEnemyManager::GetWaveSpawnPosition(int32 Index, int32 Count, const UCircularSceneManager* CircularScene, float& OutAngle) const
+{
+	// 环形场景：均匀分布在圆环上（与 SpawnEnemies 一致）
+	if (CircularScene)
+	{
+		OutAngle = Index * (2.0f * PI / FMath::Max(Count, 1));
+		return CircularScene->GetEnemyPosition(OutAngle);
+	}
+	
+	// 下落式场景：随机分布
+	OutAngle = 0.0f;
+	return FVector(
+		FMath::RandRange(-500.0f, 500.0f),
+		FMath::RandRange(-500.0f, 500.0f),
+		0.0f
+	);
+}
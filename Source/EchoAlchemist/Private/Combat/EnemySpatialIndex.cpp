@@ -0,0 +1,388 @@
+// Copyright Echo Alchemist Game. All Rights Reserved.
+
+#include "Combat/EnemySpatialIndex.h"
+
+namespace
+{
+	/** 网格单边的最大单元数（超出时自动放大单元尺寸） */
+	constexpr int32 MaxGridCellsPerAxis = 256;
+
+	/** 最大堆谓词：距离越远越靠近堆顶 */
+	struct FFartherFirst
+	{
+		template<typename T>
+		bool operator()(const T& A, const T& B) const
+		{
+			return A.DistSquared > B.DistSquared;
+		}
+	};
+}
+
+FEnemySpatialIndex::FEnemySpatialIndex()
+{
+	Reset();
+}
+
+void FEnemySpatialIndex::BeginAngular(const FVector& InCenter, int32 InBucketCount)
+{
+	Mode = EMode::Angular;
+	Center = InCenter;
+	BucketCount = FMath::Max(InBucketCount, 1);
+	BucketAngle = (2.0f * PI) / BucketCount;
+	
+	Staging.Reset();
+	StagingAngles.Reset();
+}
+
+void FEnemySpatialIndex::BeginGrid(float InCellSize)
+{
+	Mode = EMode::Grid;
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	
+	Staging.Reset();
+	StagingAngles.Reset();
+}
+
+void FEnemySpatialIndex::Add(int32 EnemyIndex, const FVector& Position, float Angle)
+{
+	FEntry& Entry = Staging.AddUninitialized_GetRef();
+	Entry.Position = Position;
+	Entry.EnemyIndex = EnemyIndex;
+	Entry.Bucket = 0;
+	
+	if (Mode == EMode::Angular)
+	{
+		StagingAngles.Add(Angle);
+	}
+}
+
+void FEnemySpatialIndex::Finalize()
+{
+	// 网格分桶：网格范围由当前敌人的包围盒决定
+	if (Mode == EMode::Grid)
+	{
+		FVector2D Min(FLT_MAX, FLT_MAX);
+		FVector2D Max(-FLT_MAX, -FLT_MAX);
+		for (const FEntry& Entry : Staging)
+		{
+			Min.X = FMath::Min(Min.X, static_cast<double>(Entry.Position.X));
+			Min.Y = FMath::Min(Min.Y, static_cast<double>(Entry.Position.Y));
+			Max.X = FMath::Max(Max.X, static_cast<double>(Entry.Position.X));
+			Max.Y = FMath::Max(Max.Y, static_cast<double>(Entry.Position.Y));
+		}
+		
+		if (Staging.Num() == 0)
+		{
+			Min = Max = FVector2D::ZeroVector;
+		}
+		
+		// 敌人分布过广时放大单元尺寸，保证网格规模有上限
+		const FVector2D Extent = Max - Min;
+		const float LargestExtent = static_cast<float>(FMath::Max(Extent.X, Extent.Y));
+		CellSize = FMath::Max(CellSize, LargestExtent / (MaxGridCellsPerAxis - 1));
+		
+		GridOrigin = Min;
+		GridDimensions.X = FMath::FloorToInt32(static_cast<float>(Extent.X) / CellSize) + 1;
+		GridDimensions.Y = FMath::FloorToInt32(static_cast<float>(Extent.Y) / CellSize) + 1;
+		BucketCount = GridDimensions.X * GridDimensions.Y;
+	}
+	
+	// 计数排序：统计每个桶的数量
+	BucketStart.Reset();
+	BucketStart.SetNumZeroed(BucketCount + 1);
+	
+	for (int32 i = 0; i < Staging.Num(); ++i)
+	{
+		FEntry& Entry = Staging[i];
+		if (Mode == EMode::Angular)
+		{
+			Entry.Bucket = AngleToBucket(StagingAngles[i]);
+		}
+		else
+		{
+			const FIntPoint Cell = PositionToCell(Entry.Position);
+			Entry.Bucket = FMath::Clamp(Cell.Y, 0, GridDimensions.Y - 1) * GridDimensions.X 
+				+ FMath::Clamp(Cell.X, 0, GridDimensions.X - 1);
+		}
+		BucketStart[Entry.Bucket + 1]++;
+	}
+	
+	for (int32 Bucket = 0; Bucket < BucketCount; ++Bucket)
+	{
+		BucketStart[Bucket + 1] += BucketStart[Bucket];
+	}
+	
+	// 按桶写入
+	WriteCursor.Reset();
+	WriteCursor.Append(BucketStart.GetData(), BucketCount);
+	Entries.SetNumUninitialized(Staging.Num(), EAllowShrinking::No);
+	
+	for (const FEntry& Entry : Staging)
+	{
+		Entries[WriteCursor[Entry.Bucket]++] = Entry;
+	}
+	
+	Staging.Reset();
+	StagingAngles.Reset();
+}
+
+void FEnemySpatialIndex::Reset()
+{
+	Mode = EMode::Angular;
+	BucketCount = 1;
+	BucketAngle = 2.0f * PI;
+	BucketStart.Reset();
+	BucketStart.SetNumZeroed(2);
+	Entries.Reset();
+	Staging.Reset();
+	StagingAngles.Reset();
+}
+
+int32 FEnemySpatialIndex::QueryRadius(const FVector& Position, float Radius, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	
+	if (Entries.Num() == 0 || Radius < 0.0f)
+	{
+		return 0;
+	}
+	
+	const float RadiusSquared = FMath::Square(Radius);
+	
+	auto GatherRange = [&](int32 Bucket)
+	{
+		for (int32 i = BucketStart[Bucket]; i < BucketStart[Bucket + 1]; ++i)
+		{
+			if (FVector::DistSquared(Position, Entries[i].Position) <= RadiusSquared)
+			{
+				OutIndices.Add(Entries[i].EnemyIndex);
+			}
+		}
+	};
+	
+	if (Mode == EMode::Angular)
+	{
+		const FVector Relative = Position - Center;
+		const float QueryRadius2D = static_cast<float>(Relative.Size2D());
+		
+		// 查询圆包含圆心：所有扇区都可能命中
+		if (QueryRadius2D <= Radius)
+		{
+			for (int32 Bucket = 0; Bucket < BucketCount; ++Bucket)
+			{
+				GatherRange(Bucket);
+			}
+			return OutIndices.Num();
+		}
+		
+		// 从圆心看查询圆的张角为 ±asin(R / r)
+		const float QueryAngle = FMath::Atan2(static_cast<float>(Relative.Y), static_cast<float>(Relative.X));
+		const float HalfSpan = FMath::Asin(Radius / QueryRadius2D);
+		const int32 FirstBucket = AngleToBucket(QueryAngle - HalfSpan);
+		const int32 LastBucket = AngleToBucket(QueryAngle + HalfSpan);
+		const int32 Span = (LastBucket - FirstBucket + BucketCount) % BucketCount;
+		
+		for (int32 Step = 0; Step <= Span; ++Step)
+		{
+			GatherRange((FirstBucket + Step) % BucketCount);
+		}
+	}
+	else
+	{
+		const FIntPoint MinCell = PositionToCell(Position - FVector(Radius));
+		const FIntPoint MaxCell = PositionToCell(Position + FVector(Radius));
+		
+		const int32 MinX = FMath::Max(MinCell.X, 0);
+		const int32 MinY = FMath::Max(MinCell.Y, 0);
+		const int32 MaxX = FMath::Min(MaxCell.X, GridDimensions.X - 1);
+		const int32 MaxY = FMath::Min(MaxCell.Y, GridDimensions.Y - 1);
+		
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				GatherRange(Y * GridDimensions.X + X);
+			}
+		}
+	}
+	
+	return OutIndices.Num();
+}
+
+int32 FEnemySpatialIndex::QueryKNearest(const FVector& Position, int32 K, float MaxRadius, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	
+	if (Entries.Num() == 0 || K <= 0)
+	{
+		return 0;
+	}
+	
+	const float MaxDistSquared = MaxRadius > 0.0f ? FMath::Square(MaxRadius) : FLT_MAX;
+	
+	TArray<FCandidate> Heap;
+	Heap.Reserve(K);
+	
+	if (Mode == EMode::Angular)
+	{
+		QueryKNearestAngular(Position, K, MaxDistSquared, Heap);
+	}
+	else
+	{
+		QueryKNearestGrid(Position, K, MaxDistSquared, Heap);
+	}
+	
+	// 从近到远输出
+	Heap.Sort([](const FCandidate& A, const FCandidate& B)
+	{
+		return A.DistSquared < B.DistSquared;
+	});
+	
+	OutIndices.Reserve(Heap.Num());
+	for (const FCandidate& Candidate : Heap)
+	{
+		OutIndices.Add(Candidate.EnemyIndex);
+	}
+	
+	return OutIndices.Num();
+}
+
+int32 FEnemySpatialIndex::AngleToBucket(float Angle) const
+{
+	float Normalized = FMath::Fmod(Angle, 2.0f * PI);
+	if (Normalized < 0.0f)
+	{
+		Normalized += 2.0f * PI;
+	}
+	
+	return FMath::Clamp(FMath::FloorToInt32(Normalized / BucketAngle), 0, BucketCount - 1);
+}
+
+FIntPoint FEnemySpatialIndex::PositionToCell(const FVector& Position) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32(static_cast<float>(Position.X - GridOrigin.X) / CellSize),
+		FMath::FloorToInt32(static_cast<float>(Position.Y - GridOrigin.Y) / CellSize)
+	);
+}
+
+void FEnemySpatialIndex::GatherBucket(int32 Bucket, const FVector& Position, int32 K, float MaxDistSquared, TArray<FCandidate>& Heap) const
+{
+	for (int32 i = BucketStart[Bucket]; i < BucketStart[Bucket + 1]; ++i)
+	{
+		const FEntry& Entry = Entries[i];
+		const float DistSquared = static_cast<float>(FVector::DistSquared(Position, Entry.Position));
+		if (DistSquared > MaxDistSquared)
+		{
+			continue;
+		}
+		
+		if (Heap.Num() < K)
+		{
+			Heap.HeapPush(FCandidate{ DistSquared, Entry.EnemyIndex }, FFartherFirst());
+		}
+		else if (DistSquared < Heap.HeapTop().DistSquared)
+		{
+			Heap.HeapPopDiscard(FFartherFirst(), EAllowShrinking::No);
+			Heap.HeapPush(FCandidate{ DistSquared, Entry.EnemyIndex }, FFartherFirst());
+		}
+	}
+}
+
+float FEnemySpatialIndex::KthDistSquared(const TArray<FCandidate>& Heap, int32 K, float MaxDistSquared)
+{
+	return Heap.Num() < K ? MaxDistSquared : Heap.HeapTop().DistSquared;
+}
+
+void FEnemySpatialIndex::QueryKNearestAngular(const FVector& Position, int32 K, float MaxDistSquared, TArray<FCandidate>& Heap) const
+{
+	const FVector Relative = Position - Center;
+	const float QueryRadius2D = static_cast<float>(Relative.Size2D());
+	const float QueryAngle = FMath::Atan2(static_cast<float>(Relative.Y), static_cast<float>(Relative.X));
+	const int32 HomeBucket = AngleToBucket(QueryAngle);
+	
+	GatherBucket(HomeBucket, Position, K, MaxDistSquared, Heap);
+	
+	const int32 HalfCount = BucketCount / 2;
+	for (int32 Step = 1; Step <= HalfCount; ++Step)
+	{
+		// 相隔Step个扇区的桶，与查询点的角度差至少为 (Step - 1) 个扇区宽度；
+		// 到该方向射线的最短距离为 r * sin(角度差)（超过90度时为 r）
+		const float MinAngle = (Step - 1) * BucketAngle;
+		const float LowerBound = MinAngle >= HALF_PI ? QueryRadius2D : QueryRadius2D * FMath::Sin(MinAngle);
+		if (FMath::Square(LowerBound) > KthDistSquared(Heap, K, MaxDistSquared))
+		{
+			break;
+		}
+		
+		const int32 Right = (HomeBucket + Step) % BucketCount;
+		const int32 Left = (HomeBucket - Step + BucketCount) % BucketCount;
+		GatherBucket(Right, Position, K, MaxDistSquared, Heap);
+		if (Left != Right)
+		{
+			GatherBucket(Left, Position, K, MaxDistSquared, Heap);
+		}
+	}
+}
+
+void FEnemySpatialIndex::QueryKNearestGrid(const FVector& Position, int32 K, float MaxDistSquared, TArray<FCandidate>& Heap) const
+{
+	const FIntPoint Home = PositionToCell(Position);
+	
+	const int32 MaxCellX = GridDimensions.X - 1;
+	const int32 MaxCellY = GridDimensions.Y - 1;
+	
+	// 收集一行（只访问网格内的单元）
+	auto GatherRow = [&](int32 Y, int32 FromX, int32 ToX)
+	{
+		if (Y < 0 || Y > MaxCellY)
+		{
+			return;
+		}
+		for (int32 X = FMath::Max(FromX, 0); X <= FMath::Min(ToX, MaxCellX); ++X)
+		{
+			GatherBucket(Y * GridDimensions.X + X, Position, K, MaxDistSquared, Heap);
+		}
+	};
+	
+	// 收集一列（只访问网格内的单元）
+	auto GatherColumn = [&](int32 X, int32 FromY, int32 ToY)
+	{
+		if (X < 0 || X > MaxCellX)
+		{
+			return;
+		}
+		for (int32 Y = FMath::Max(FromY, 0); Y <= FMath::Min(ToY, MaxCellY); ++Y)
+		{
+			GatherBucket(Y * GridDimensions.X + X, Position, K, MaxDistSquared, Heap);
+		}
+	};
+	
+	// 覆盖整个网格所需的最大环数（查询点可能在网格外）
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(Home.X), FMath::Abs(GridDimensions.X - 1 - Home.X)),
+		FMath::Max(FMath::Abs(Home.Y), FMath::Abs(GridDimensions.Y - 1 - Home.Y)));
+	
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		// 第Ring环中的点与查询点的距离至少为 (Ring - 1) 个单元
+		if (Ring > 0 && FMath::Square((Ring - 1) * CellSize) > KthDistSquared(Heap, K, MaxDistSquared))
+		{
+			break;
+		}
+		
+		if (Ring == 0)
+		{
+			GatherRow(Home.Y, Home.X, Home.X);
+			continue;
+		}
+		
+		// 上下两行
+		GatherRow(Home.Y - Ring, Home.X - Ring, Home.X + Ring);
+		GatherRow(Home.Y + Ring, Home.X - Ring, Home.X + Ring);
+		
+		// 左右两列（不含角）
+		GatherColumn(Home.X - Ring, Home.Y - Ring + 1, Home.Y + Ring - 1);
+		GatherColumn(Home.X + Ring, Home.Y - Ring + 1, Home.Y + Ring - 1);
+	}
+}
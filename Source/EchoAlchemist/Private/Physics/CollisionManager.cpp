@@ -135,10 +135,21 @@ void UCollisionManager::GetSpatialGridStatistics(int32& OutTotalCells, int32& Ou
 TArray<FEchoCollisionEvent> UCollisionManager::DetectCollisions()
 {
 	TArray<FEchoCollisionEvent> Collisions;
+	DetectCollisionsDeferred(Collisions);
+	
+	// 触发事件
+	BroadcastCollisionEvents(Collisions);
+	
+	return Collisions;
+}
+
+int32 UCollisionManager::DetectCollisionsDeferred(TArray<FEchoCollisionEvent>& OutCollisions)
+{
+	OutCollisions.Reset();
 	
 	if (!bIsInitialized || !SpatialGrid.IsValid())
 	{
-		return Collisions;
+		return 0;
 	}
 	
 	// 使用集合记录已检测的碰撞对，避免重复检测
@@ -177,15 +188,28 @@ TArray<FEchoCollisionEvent> UCollisionManager::DetectCollisions()
 			if (CheckCollision(BodyA, BodyB, Event))
 			{
 				Event.Timestamp = CurrentGameTime;
-				Collisions.Add(Event);
-				
-				// 触发事件
-				OnCollision.Broadcast(Event);
+				OutCollisions.Add(Event);
 			}
 		}
 	}
 	
-	return Collisions;
+	return OutCollisions.Num();
+}
+
+void UCollisionManager::BroadcastCollisionEvents(const TArray<FEchoCollisionEvent>& Collisions)
+{
+	if (!OnCollision.IsBound())
+	{
+		return;
+	}
+	
+	// 委托可能绑定了蓝图，只能在游戏线程广播
+	check(IsInGameThread());
+	
+	for (const FEchoCollisionEvent& Event : Collisions)
+	{
+		OnCollision.Broadcast(Event);
+	}
 }
 
 int32 UCollisionManager::DetectCollisionsForBody(const FGuid& BodyID, TArray<FEchoCollisionEvent>& OutCollisions)
@@ -51,6 +51,7 @@ FGuid UMarblePhysicsSystem::LaunchMarble(const FMarbleLaunchParams& Params)
 	NewMarble.PotencyMultiplier = Params.PotencyMultiplier;
 	NewMarble.MaxPotencyMultiplier = Params.PotencyMultiplier;
 	NewMarble.Generation = Params.Generation;
+	NewMarble.PotionType = Params.PotionType;
 	NewMarble.CreationTime = CurrentGameTime;
 	NewMarble.LastUpdateTime = CurrentGameTime;
 	
@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingActivityMap.h"
+
+void FWorldMorphingActivityMap::Init(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(0, InWidth);
+	Height = FMath::Max(0, InHeight);
+	TilesX = FMath::DivideAndRoundUp(Width, TileSize);
+	TilesY = FMath::DivideAndRoundUp(Height, TileSize);
+
+	const int32 TileCount = TilesX * TilesY;
+	Active.Init(1, TileCount);
+	Previous.Init(0, TileCount);
+	Processed.Init(1, TileCount);
+}
+
+void FWorldMorphingActivityMap::Reset()
+{
+	Width = 0;
+	Height = 0;
+	TilesX = 0;
+	TilesY = 0;
+	Active.Empty();
+	Previous.Empty();
+	Processed.Empty();
+}
+
+void FWorldMorphingActivityMap::Refresh(const FWorldMorphingGrid& Grid, TFunctionRef<bool(int32 Index)> IsActiveCell, int32 Dilation)
+{
+	// 只有上一步标记或处理过的块可能包含活跃单元格
+	Swap(Active, Previous);
+	for (int32 TileY = 0; TileY < TilesY; ++TileY)
+	{
+		for (int32 TileX = 0; TileX < TilesX; ++TileX)
+		{
+			const int32 Tile = TileY * TilesX + TileX;
+			Active[Tile] = (Previous[Tile] || Processed[Tile]) && TileHasActiveCell(Grid, TileX, TileY, IsActiveCell);
+		}
+	}
+
+	// 处理集合 = (当前活跃 ∪ 上一步活跃) 向外扩展 Dilation 个块
+	FMemory::Memzero(Processed.GetData(), Processed.Num());
+	for (int32 TileY = 0; TileY < TilesY; ++TileY)
+	{
+		for (int32 TileX = 0; TileX < TilesX; ++TileX)
+		{
+			const int32 Tile = TileY * TilesX + TileX;
+			if (!Active[Tile] && !Previous[Tile]) continue;
+
+			for (int32 Y = FMath::Max(0, TileY - Dilation); Y <= FMath::Min(TilesY - 1, TileY + Dilation); ++Y)
+			{
+				for (int32 X = FMath::Max(0, TileX - Dilation); X <= FMath::Min(TilesX - 1, TileX + Dilation); ++X)
+				{
+					Processed[Y * TilesX + X] = 1;
+				}
+			}
+		}
+	}
+}
+
+void FWorldMorphingActivityMap::MarkCell(const FWorldMorphingGrid& Grid, int32 Index)
+{
+	const int32 TileX = Grid.GetX(Index) / TileSize;
+	const int32 TileY = Grid.GetY(Index) / TileSize;
+	Active[TileY * TilesX + TileX] = 1;
+}
+
+void FWorldMorphingActivityMap::ForEachSpan(const FWorldMorphingGrid& Grid, int32 TileY, TFunctionRef<void(int32 BeginIndex, int32 EndIndex)> Body) const
+{
+	const uint8* Row = Processed.GetData() + TileY * TilesX;
+	const int32 RowBegin = TileY * TileSize;
+	const int32 RowEnd = FMath::Min(RowBegin + TileSize, Height);
+
+	int32 TileX = 0;
+	while (TileX < TilesX)
+	{
+		if (!Row[TileX])
+		{
+			TileX++;
+			continue;
+		}
+
+		// 合并相邻的处理块
+		const int32 FirstTile = TileX;
+		while (TileX < TilesX && Row[TileX])
+		{
+			TileX++;
+		}
+
+		const int32 BeginX = FirstTile * TileSize;
+		const int32 EndX = FMath::Min(TileX * TileSize, Width);
+		for (int32 Y = RowBegin; Y < RowEnd; ++Y)
+		{
+			const int32 RowStart = Grid.ToIndex(0, Y);
+			Body(RowStart + BeginX, RowStart + EndX);
+		}
+	}
+}
+
+bool FWorldMorphingActivityMap::TileHasActiveCell(const FWorldMorphingGrid& Grid, int32 TileX, int32 TileY, TFunctionRef<bool(int32 Index)> IsActiveCell) const
+{
+	const int32 BeginX = TileX * TileSize;
+	const int32 EndX = FMath::Min(BeginX + TileSize, Width);
+	const int32 EndY = FMath::Min((TileY + 1) * TileSize, Height);
+
+	for (int32 Y = TileY * TileSize; Y < EndY; ++Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		for (int32 X = BeginX; X < EndX; ++X)
+		{
+			if (IsActiveCell(RowStart + X))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
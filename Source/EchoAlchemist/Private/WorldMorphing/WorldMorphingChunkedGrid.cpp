@@ -0,0 +1,279 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingChunkedGrid.h"
+#include "Async/ParallelFor.h"
+
+// ========== FWorldMorphingChunk ==========
+void FWorldMorphingChunk::ResetCell(int32 Index, bool bValid)
+{
+	Flags[Index] = bValid ? EWorldCellFlags::Valid : EWorldCellFlags::None;
+	CrystalState[Index] = ECrystalType::Empty;
+	MantleEnergy[Index] = 0.0f;
+	Temperature[Index] = 0.0f;
+	TemperatureChange[Index] = 0.0f;
+	CrystalEnergy[Index] = 0.0f;
+	StoredEnergy[Index] = 10.0f;
+	Prosperity[Index] = 0.0f;
+}
+
+void FWorldMorphingChunk::CopyCell(int32 Index, const FWorldMorphingChunk& Source, int32 SourceIndex)
+{
+	Flags[Index] = Source.Flags[SourceIndex];
+	CrystalState[Index] = Source.CrystalState[SourceIndex];
+	MantleEnergy[Index] = Source.MantleEnergy[SourceIndex];
+	Temperature[Index] = Source.Temperature[SourceIndex];
+	TemperatureChange[Index] = Source.TemperatureChange[SourceIndex];
+	CrystalEnergy[Index] = Source.CrystalEnergy[SourceIndex];
+	StoredEnergy[Index] = Source.StoredEnergy[SourceIndex];
+	Prosperity[Index] = Source.Prosperity[SourceIndex];
+}
+
+bool FWorldMorphingChunk::HasLand() const
+{
+	for (int32 LocalY = 0; LocalY < Size; ++LocalY)
+	{
+		for (int32 LocalX = 0; LocalX < Size; ++LocalX)
+		{
+			if (EnumHasAnyFlags(Flags[ToLocalIndex(LocalX, LocalY)], EWorldCellFlags::Exists))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// ========== FWorldMorphingChunkedGrid ==========
+void FWorldMorphingChunkedGrid::Init(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(0, InWidth);
+	Height = FMath::Max(0, InHeight);
+	ChunksX = FMath::DivideAndRoundUp(Width, FWorldMorphingChunk::Size);
+	ChunksY = FMath::DivideAndRoundUp(Height, FWorldMorphingChunk::Size);
+
+	Chunks.Empty();
+	Chunks.SetNum(ChunksX * ChunksY);
+}
+
+void FWorldMorphingChunkedGrid::Empty()
+{
+	Width = 0;
+	Height = 0;
+	ChunksX = 0;
+	ChunksY = 0;
+	Chunks.Empty();
+}
+
+void FWorldMorphingChunkedGrid::FromGrid(const FWorldMorphingGrid& Grid)
+{
+	Init(Grid.Width, Grid.Height);
+
+	for (int32 ChunkY = 0; ChunkY < ChunksY; ++ChunkY)
+	{
+		for (int32 ChunkX = 0; ChunkX < ChunksX; ++ChunkX)
+		{
+			const int32 BeginX = ChunkX * FWorldMorphingChunk::Size;
+			const int32 BeginY = ChunkY * FWorldMorphingChunk::Size;
+			const int32 EndX = FMath::Min(BeginX + FWorldMorphingChunk::Size, Width);
+			const int32 EndY = FMath::Min(BeginY + FWorldMorphingChunk::Size, Height);
+
+			// 只为包含地形的块分配
+			bool bHasLand = false;
+			for (int32 Y = BeginY; Y < EndY && !bHasLand; ++Y)
+			{
+				for (int32 X = BeginX; X < EndX; ++X)
+				{
+					if (Grid.Exists(Grid.ToIndex(X, Y)))
+					{
+						bHasLand = true;
+						break;
+					}
+				}
+			}
+
+			if (!bHasLand) continue;
+
+			FWorldMorphingChunk& Chunk = FindOrAddChunk(ChunkX, ChunkY);
+			for (int32 Y = BeginY; Y < EndY; ++Y)
+			{
+				for (int32 X = BeginX; X < EndX; ++X)
+				{
+					const int32 Index = Grid.ToIndex(X, Y);
+					const int32 LocalIndex = FWorldMorphingChunk::ToLocalIndex(X - BeginX, Y - BeginY);
+					Chunk.Flags[LocalIndex] = Grid.Flags[Index];
+					Chunk.CrystalState[LocalIndex] = Grid.CrystalState[Index];
+					Chunk.MantleEnergy[LocalIndex] = Grid.MantleEnergy[Index];
+					Chunk.Temperature[LocalIndex] = Grid.Temperature[Index];
+					Chunk.TemperatureChange[LocalIndex] = Grid.TemperatureChange[Index];
+					Chunk.CrystalEnergy[LocalIndex] = Grid.CrystalEnergy[Index];
+					Chunk.StoredEnergy[LocalIndex] = Grid.StoredEnergy[Index];
+					Chunk.Prosperity[LocalIndex] = Grid.Prosperity[Index];
+				}
+			}
+		}
+	}
+
+	ExchangeHalos();
+}
+
+void FWorldMorphingChunkedGrid::ToGrid(FWorldMorphingGrid& OutGrid) const
+{
+	OutGrid.Init(Width, Height);
+
+	for (const TUniquePtr<FWorldMorphingChunk>& ChunkPtr : Chunks)
+	{
+		if (!ChunkPtr) continue;
+
+		const FWorldMorphingChunk& Chunk = *ChunkPtr;
+		const int32 BeginX = Chunk.ChunkX * FWorldMorphingChunk::Size;
+		const int32 BeginY = Chunk.ChunkY * FWorldMorphingChunk::Size;
+		const int32 EndX = FMath::Min(BeginX + FWorldMorphingChunk::Size, Width);
+		const int32 EndY = FMath::Min(BeginY + FWorldMorphingChunk::Size, Height);
+
+		for (int32 Y = BeginY; Y < EndY; ++Y)
+		{
+			for (int32 X = BeginX; X < EndX; ++X)
+			{
+				const int32 Index = OutGrid.ToIndex(X, Y);
+				const int32 LocalIndex = FWorldMorphingChunk::ToLocalIndex(X - BeginX, Y - BeginY);
+				OutGrid.Flags[Index] = Chunk.Flags[LocalIndex];
+				OutGrid.CrystalState[Index] = Chunk.CrystalState[LocalIndex];
+				OutGrid.MantleEnergy[Index] = Chunk.MantleEnergy[LocalIndex];
+				OutGrid.Temperature[Index] = Chunk.Temperature[LocalIndex];
+				OutGrid.TemperatureChange[Index] = Chunk.TemperatureChange[LocalIndex];
+				OutGrid.CrystalEnergy[Index] = Chunk.CrystalEnergy[LocalIndex];
+				OutGrid.StoredEnergy[Index] = Chunk.StoredEnergy[LocalIndex];
+				OutGrid.Prosperity[Index] = Chunk.Prosperity[LocalIndex];
+			}
+		}
+	}
+}
+
+void FWorldMorphingChunkedGrid::ExchangeHalos()
+{
+	const int32 Size = FWorldMorphingChunk::Size;
+
+	// 每个块只写自己的光晕、只读相邻块的内部，可以并行
+	ParallelForChunks([this, Size](FWorldMorphingChunk& Chunk)
+	{
+		const int32 BaseX = Chunk.ChunkX * Size;
+		const int32 BaseY = Chunk.ChunkY * Size;
+
+		for (int32 LocalY = -1; LocalY <= Size; ++LocalY)
+		{
+			// 内部行只处理左右两个光晕单元格
+			const int32 StepX = (LocalY == -1 || LocalY == Size) ? 1 : Size + 1;
+			for (int32 LocalX = -1; LocalX <= Size; LocalX += StepX)
+			{
+				const int32 X = BaseX + LocalX;
+				const int32 Y = BaseY + LocalY;
+				const int32 LocalIndex = FWorldMorphingChunk::ToLocalIndex(LocalX, LocalY);
+
+				const FWorldMorphingChunk* Source = IsInWorld(X, Y) ? FindChunk(X / Size, Y / Size) : nullptr;
+				if (Source)
+				{
+					Chunk.CopyCell(LocalIndex, *Source, FWorldMorphingChunk::ToLocalIndex(X - Source->ChunkX * Size, Y - Source->ChunkY * Size));
+				}
+				else
+				{
+					// 世界之外按光晕处理，未分配的块按海洋处理
+					Chunk.ResetCell(LocalIndex, IsInWorld(X, Y));
+				}
+			}
+		}
+	});
+}
+
+void FWorldMorphingChunkedGrid::ParallelForChunks(TFunctionRef<void(FWorldMorphingChunk& Chunk)> Body)
+{
+	TArray<FWorldMorphingChunk*> Allocated;
+	for (TUniquePtr<FWorldMorphingChunk>& ChunkPtr : Chunks)
+	{
+		if (ChunkPtr)
+		{
+			Allocated.Add(ChunkPtr.Get());
+		}
+	}
+
+	ParallelFor(Allocated.Num(), [&Allocated, &Body](int32 i)
+	{
+		Body(*Allocated[i]);
+	});
+}
+
+FWorldMorphingChunk* FWorldMorphingChunkedGrid::FindChunk(int32 ChunkX, int32 ChunkY)
+{
+	if (ChunkX < 0 || ChunkX >= ChunksX || ChunkY < 0 || ChunkY >= ChunksY)
+	{
+		return nullptr;
+	}
+	return Chunks[ChunkY * ChunksX + ChunkX].Get();
+}
+
+const FWorldMorphingChunk* FWorldMorphingChunkedGrid::FindChunk(int32 ChunkX, int32 ChunkY) const
+{
+	return const_cast<FWorldMorphingChunkedGrid*>(this)->FindChunk(ChunkX, ChunkY);
+}
+
+FWorldMorphingChunk& FWorldMorphingChunkedGrid::FindOrAddChunk(int32 ChunkX, int32 ChunkY)
+{
+	check(ChunkX >= 0 && ChunkX < ChunksX && ChunkY >= 0 && ChunkY < ChunksY);
+
+	TUniquePtr<FWorldMorphingChunk>& ChunkPtr = Chunks[ChunkY * ChunksX + ChunkX];
+	if (!ChunkPtr)
+	{
+		ChunkPtr = MakeUnique<FWorldMorphingChunk>();
+		ChunkPtr->ChunkX = ChunkX;
+		ChunkPtr->ChunkY = ChunkY;
+
+		const int32 BaseX = ChunkX * FWorldMorphingChunk::Size;
+		const int32 BaseY = ChunkY * FWorldMorphingChunk::Size;
+		for (int32 LocalY = -1; LocalY <= FWorldMorphingChunk::Size; ++LocalY)
+		{
+			for (int32 LocalX = -1; LocalX <= FWorldMorphingChunk::Size; ++LocalX)
+			{
+				ChunkPtr->ResetCell(FWorldMorphingChunk::ToLocalIndex(LocalX, LocalY), IsInWorld(BaseX + LocalX, BaseY + LocalY));
+			}
+		}
+	}
+
+	return *ChunkPtr;
+}
+
+FCellState FWorldMorphingChunkedGrid::GetCellState(int32 X, int32 Y) const
+{
+	FCellState State;
+	if (!IsInWorld(X, Y))
+	{
+		return State;
+	}
+
+	const int32 Size = FWorldMorphingChunk::Size;
+	const FWorldMorphingChunk* Chunk = FindChunk(X / Size, Y / Size);
+	if (!Chunk)
+	{
+		State.StoredEnergy = 10.0f;
+		return State;
+	}
+
+	const int32 Index = FWorldMorphingChunk::ToLocalIndex(X % Size, Y % Size);
+	State.bExists = EnumHasAnyFlags(Chunk->Flags[Index], EWorldCellFlags::Exists);
+	State.MantleEnergy = Chunk->MantleEnergy[Index];
+	State.Temperature = Chunk->Temperature[Index];
+	State.bHasThunderstorm = EnumHasAnyFlags(Chunk->Flags[Index], EWorldCellFlags::Thunderstorm);
+	State.CrystalType = Chunk->CrystalState[Index];
+	State.StoredEnergy = Chunk->StoredEnergy[Index];
+	State.bIsAbsorbing = EnumHasAnyFlags(Chunk->Flags[Index], EWorldCellFlags::Absorbing);
+	State.Prosperity = Chunk->Prosperity[Index];
+	return State;
+}
+
+int32 FWorldMorphingChunkedGrid::GetNumAllocatedChunks() const
+{
+	int32 Count = 0;
+	for (const TUniquePtr<FWorldMorphingChunk>& ChunkPtr : Chunks)
+	{
+		Count += ChunkPtr ? 1 : 0;
+	}
+	return Count;
+}
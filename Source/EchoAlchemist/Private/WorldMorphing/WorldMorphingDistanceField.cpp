@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingDistanceField.h"
+
+void FWorldMorphingDistanceField::Rebuild(const FWorldMorphingGrid& Grid, int32 InMaxDistance)
+{
+	MaxDistance = FMath::Max(0, InMaxDistance);
+	Pitch = Grid.Pitch;
+
+	// 光晕单元格不存在，距离恒为0
+	Depth.Init(0, Grid.Num());
+
+	if (Grid.Width > 0 && Grid.Height > 0)
+	{
+		Sweep(Grid, 0, 0, Grid.Width - 1, Grid.Height - 1);
+	}
+}
+
+void FWorldMorphingDistanceField::Repair(const FWorldMorphingGrid& Grid, int32 Index)
+{
+	if (!IsBuiltFor(Grid, MaxDistance))
+	{
+		return;
+	}
+
+	// 棋盘距离达到上限 (MaxDistance + 1) 的单元格不受影响
+	const int32 Radius = MaxDistance;
+	const int32 X = Grid.GetX(Index);
+	const int32 Y = Grid.GetY(Index);
+
+	Sweep(Grid,
+		FMath::Max(0, X - Radius), FMath::Max(0, Y - Radius),
+		FMath::Min(Grid.Width - 1, X + Radius), FMath::Min(Grid.Height - 1, Y + Radius));
+}
+
+void FWorldMorphingDistanceField::Reset()
+{
+	Depth.Empty();
+	MaxDistance = INDEX_NONE;
+	Pitch = 0;
+}
+
+void FWorldMorphingDistanceField::Sweep(const FWorldMorphingGrid& Grid, int32 X0, int32 Y0, int32 X1, int32 Y1)
+{
+	const int32 Cap = MaxDistance + 1;
+	int32* D = Depth.GetData();
+
+	// 重置窗口，窗口外的值保持不变并作为边界条件
+	for (int32 Y = Y0; Y <= Y1; ++Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		for (int32 X = X0; X <= X1; ++X)
+		{
+			D[RowStart + X] = Grid.Exists(RowStart + X) ? Cap : 0;
+		}
+	}
+
+	// 正向扫描
+	for (int32 Y = Y0; Y <= Y1; ++Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		for (int32 X = X0; X <= X1; ++X)
+		{
+			const int32 Index = RowStart + X;
+			if (D[Index] == 0) continue;
+
+			const int32 Above = Index - Pitch;
+			const int32 Nearest = FMath::Min(FMath::Min(D[Above - 1], D[Above]), FMath::Min(D[Above + 1], D[Index - 1]));
+			D[Index] = FMath::Min(D[Index], Nearest + 1);
+		}
+	}
+
+	// 反向扫描
+	for (int32 Y = Y1; Y >= Y0; --Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		for (int32 X = X1; X >= X0; --X)
+		{
+			const int32 Index = RowStart + X;
+			if (D[Index] == 0) continue;
+
+			const int32 Below = Index + Pitch;
+			const int32 Nearest = FMath::Min(FMath::Min(D[Below - 1], D[Below]), FMath::Min(D[Below + 1], D[Index + 1]));
+			D[Index] = FMath::Min(D[Index], Nearest + 1);
+		}
+	}
+}
@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingGrid.h"
+#include "Misc/Crc.h"
+
+void FWorldMorphingGrid::Init(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(0, InWidth);
+	Height = FMath::Max(0, InHeight);
+	Pitch = Width + 2;
+
+	const int32 CellCount = Pitch * (Height + 2);
+
+	for (int32 i = 0; i < 8; ++i)
+	{
+		NeighborOffsets[i] = NeighborDY[i] * Pitch + NeighborDX[i];
+	}
+
+	Flags.Init(EWorldCellFlags::None, CellCount);
+	CrystalState.Init(ECrystalType::Empty, CellCount);
+	MantleEnergy.Init(0.0f, CellCount);
+	Temperature.Init(0.0f, CellCount);
+	TemperatureChange.Init(0.0f, CellCount);
+	CrystalEnergy.Init(0.0f, CellCount);
+	StoredEnergy.Init(10.0f, CellCount);
+	Prosperity.Init(0.0f, CellCount);
+
+	// 标记内部单元格，光晕保持为空
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		const int32 RowStart = ToIndex(0, Y);
+		for (int32 X = 0; X < Width; ++X)
+		{
+			Flags[RowStart + X] = EWorldCellFlags::Valid;
+		}
+	}
+}
+
+void FWorldMorphingGrid::Empty()
+{
+	Width = 0;
+	Height = 0;
+	Pitch = 0;
+
+	Flags.Empty();
+	CrystalState.Empty();
+	MantleEnergy.Empty();
+	Temperature.Empty();
+	TemperatureChange.Empty();
+	CrystalEnergy.Empty();
+	StoredEnergy.Empty();
+	Prosperity.Empty();
+}
+
+FCellState FWorldMorphingGrid::GetCellState(int32 Index) const
+{
+	FCellState State;
+	State.bExists = Exists(Index);
+	State.MantleEnergy = MantleEnergy[Index];
+	State.Temperature = Temperature[Index];
+	State.bHasThunderstorm = HasFlag(Index, EWorldCellFlags::Thunderstorm);
+	State.CrystalType = CrystalState[Index];
+	State.StoredEnergy = StoredEnergy[Index];
+	State.bIsAbsorbing = HasFlag(Index, EWorldCellFlags::Absorbing);
+	State.Prosperity = Prosperity[Index];
+	return State;
+}
+
+uint32 FWorldMorphingGrid::ComputeHash() const
+{
+	uint32 Hash = FCrc::MemCrc32(&Width, sizeof(Width));
+	Hash = FCrc::MemCrc32(&Height, sizeof(Height), Hash);
+	Hash = FCrc::MemCrc32(Flags.GetData(), Flags.Num() * sizeof(EWorldCellFlags), Hash);
+	Hash = FCrc::MemCrc32(CrystalState.GetData(), CrystalState.Num() * sizeof(ECrystalType), Hash);
+	for (int32 Field = 0; Field < static_cast<int32>(EWorldMorphingField::Count); ++Field)
+	{
+		const TArray<float>& Plane = GetField(static_cast<EWorldMorphingField>(Field));
+		Hash = FCrc::MemCrc32(Plane.GetData(), Plane.Num() * sizeof(float), Hash);
+	}
+	return Hash;
+}
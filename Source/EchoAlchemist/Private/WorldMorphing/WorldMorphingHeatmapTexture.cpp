@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingHeatmapTexture.h"
+#include "WorldMorphing/WorldMorphingSubsystem.h"
+#include "WorldMorphing/WorldMorphingVisualization.h"
+#include "Engine/Texture2D.h"
+#include "Math/Float16.h"
+
+UWorldMorphingHeatmapTexture* UWorldMorphingHeatmapTexture::CreateHeatmapTexture(int32 InWidth, int32 InHeight, EWorldMorphingHeatmapFormat InFormat)
+{
+	UWorldMorphingHeatmapTexture* Heatmap = NewObject<UWorldMorphingHeatmapTexture>();
+	Heatmap->Format = InFormat;
+	Heatmap->Allocate(InWidth, InHeight);
+	return Heatmap;
+}
+
+bool UWorldMorphingHeatmapTexture::UpdateFromSubsystem(UWorldMorphingSubsystem* Subsystem, EHeatmapDataType DataType, int32 Lod)
+{
+	if (!Subsystem)
+	{
+		return false;
+	}
+
+	const FWorldMorphingGrid& Grid = Subsystem->GetLodGrid(Lod);
+	if (!Texture || Grid.Width != Width || Grid.Height != Height)
+	{
+		Allocate(Grid.Width, Grid.Height);
+	}
+
+	// 活跃度是块级调试数据，只能整张更新
+	if (DataType == EHeatmapDataType::Activity)
+	{
+		const TArray<float> Activity = Subsystem->GetActivityHeatmap(Lod);
+		if (!Texture || Activity.Num() != Width * Height)
+		{
+			return false;
+		}
+
+		FIntRect Changed;
+		for (int32 Y = 0; Y < Height; ++Y)
+		{
+			StoreRow(Activity.GetData() + Y * Width, 0, Y, Width, Changed);
+		}
+		if (Changed.Area() > 0)
+		{
+			UploadRect(Changed);
+		}
+		return Changed.Area() > 0;
+	}
+
+	const FIntRect Full(0, 0, Width, Height);
+	return UpdateRegions(Grid, DataType, MakeArrayView(&Full, 1));
+}
+
+bool UWorldMorphingHeatmapTexture::UpdateRegionFromSubsystem(UWorldMorphingSubsystem* Subsystem, EHeatmapDataType DataType,
+                                                             int32 StartX, int32 StartY, int32 RegionWidth, int32 RegionHeight, int32 Lod)
+{
+	if (!Subsystem || DataType == EHeatmapDataType::Activity)
+	{
+		return UpdateFromSubsystem(Subsystem, DataType, Lod);
+	}
+
+	const FWorldMorphingGrid& Grid = Subsystem->GetLodGrid(Lod);
+	if (!Texture || Grid.Width != Width || Grid.Height != Height)
+	{
+		// 尺寸或层级变化后整张纹理都需要刷新
+		return UpdateFromSubsystem(Subsystem, DataType, Lod);
+	}
+
+	const FIntRect Region(StartX, StartY, StartX + RegionWidth, StartY + RegionHeight);
+	return UpdateRegions(Grid, DataType, MakeArrayView(&Region, 1));
+}
+
+bool UWorldMorphingHeatmapTexture::UpdateRegions(const FWorldMorphingGrid& Grid, EHeatmapDataType DataType, TConstArrayView<FIntRect> DirtyRects)
+{
+	if (!Texture || Grid.Width != Width || Grid.Height != Height)
+	{
+		return false;
+	}
+
+	TArray<float, TInlineAllocator<1024>> Row;
+	Row.SetNumUninitialized(Width);
+
+	bool bUploaded = false;
+	for (const FIntRect& Dirty : DirtyRects)
+	{
+		const FIntRect Rect(
+			FMath::Max(Dirty.Min.X, 0), FMath::Max(Dirty.Min.Y, 0),
+			FMath::Min(Dirty.Max.X, Width), FMath::Min(Dirty.Max.Y, Height));
+		if (Rect.Width() <= 0 || Rect.Height() <= 0) continue;
+
+		// 只上传像素实际变化的部分
+		FIntRect Changed;
+		for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+		{
+			UWorldMorphingVisualization::NormalizeHeatmapRow(Grid, DataType, Y, Rect.Min.X, Rect.Max.X, Row.GetData());
+			StoreRow(Row.GetData(), Rect.Min.X, Y, Rect.Width(), Changed);
+		}
+
+		if (Changed.Area() > 0)
+		{
+			UploadRect(Changed);
+			bUploaded = true;
+		}
+	}
+
+	return bUploaded;
+}
+
+void UWorldMorphingHeatmapTexture::Allocate(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(0, InWidth);
+	Height = FMath::Max(0, InHeight);
+	Pixels.Init(0, Width * Height * GetBytesPerPixel());
+	Texture = nullptr;
+
+	if (Width == 0 || Height == 0)
+	{
+		return;
+	}
+
+	Texture = UTexture2D::CreateTransient(Width, Height, Format == EWorldMorphingHeatmapFormat::G8 ? PF_G8 : PF_R16F);
+	if (!Texture)
+	{
+		return;
+	}
+
+	Texture->SRGB = false;
+	Texture->Filter = TF_Nearest;
+
+	// 初始内容与像素副本一致（全0）
+	FTexturePlatformData* PlatformData = Texture->GetPlatformData();
+	if (PlatformData && PlatformData->Mips.Num() > 0)
+	{
+		FTexture2DMipMap& Mip = PlatformData->Mips[0];
+		void* Data = Mip.BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memzero(Data, Pixels.Num());
+		Mip.BulkData.Unlock();
+	}
+
+	Texture->UpdateResource();
+}
+
+void UWorldMorphingHeatmapTexture::StoreRow(const float* Values, int32 X, int32 Y, int32 Count, FIntRect& InOutChanged)
+{
+	int32 FirstChanged = INDEX_NONE;
+	int32 LastChanged = INDEX_NONE;
+
+	if (Format == EWorldMorphingHeatmapFormat::G8)
+	{
+		uint8* Row = Pixels.GetData() + Y * Width + X;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const uint8 Value = static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Values[i], 0.0f, 1.0f) * 255.0f));
+			if (Row[i] != Value)
+			{
+				Row[i] = Value;
+				FirstChanged = FirstChanged == INDEX_NONE ? i : FirstChanged;
+				LastChanged = i;
+			}
+		}
+	}
+	else
+	{
+		uint16* Row = reinterpret_cast<uint16*>(Pixels.GetData()) + Y * Width + X;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const uint16 Value = FFloat16(Values[i]).Encoded;
+			if (Row[i] != Value)
+			{
+				Row[i] = Value;
+				FirstChanged = FirstChanged == INDEX_NONE ? i : FirstChanged;
+				LastChanged = i;
+			}
+		}
+	}
+
+	if (FirstChanged == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FIntRect RowChanged(X + FirstChanged, Y, X + LastChanged + 1, Y + 1);
+	if (InOutChanged.Area() > 0)
+	{
+		InOutChanged.Union(RowChanged);
+	}
+	else
+	{
+		InOutChanged = RowChanged;
+	}
+}
+
+void UWorldMorphingHeatmapTexture::UploadRect(const FIntRect& Rect)
+{
+	if (!Texture)
+	{
+		return;
+	}
+
+	// 渲染线程稍后才读取数据，提交的是矩形的独立副本
+	const int32 BytesPerPixel = GetBytesPerPixel();
+	const int32 RowBytes = Rect.Width() * BytesPerPixel;
+	uint8* Data = new uint8[RowBytes * Rect.Height()];
+	for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+	{
+		FMemory::Memcpy(Data + (Y - Rect.Min.Y) * RowBytes, Pixels.GetData() + (Y * Width + Rect.Min.X) * BytesPerPixel, RowBytes);
+	}
+
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(Rect.Min.X, Rect.Min.Y, 0, 0, Rect.Width(), Rect.Height());
+	Texture->UpdateTextureRegions(0, 1, Region, RowBytes, BytesPerPixel, Data,
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+		{
+			delete[] SrcData;
+			delete Regions;
+		});
+}
@@ -0,0 +1,283 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingKernels.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	/** 晶石的冷却量 */
+	FORCEINLINE float GetCrystalCooling(ECrystalType CrystalType)
+	{
+		if (CrystalType == ECrystalType::Alpha)
+		{
+			return 0.5f;
+		}
+		if (CrystalType == ECrystalType::Beta)
+		{
+			return 0.2f;
+		}
+		return 0.0f;
+	}
+
+	/** 加载4个单元格的晶石冷却量 */
+	FORCEINLINE VectorRegister4Float LoadCrystalCooling(const ECrystalType* CrystalState)
+	{
+		alignas(16) float Cooling[4];
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			Cooling[Lane] = GetCrystalCooling(CrystalState[Lane]);
+		}
+		return VectorLoadAligned(Cooling);
+	}
+}
+
+void WorldMorphingKernels::BuildExistsMask(const EWorldCellFlags* Flags, float* OutMask, int32 Begin, int32 Count)
+{
+	for (int32 Index = Begin; Index < Begin + Count; ++Index)
+	{
+		OutMask[Index] = EnumHasAnyFlags(Flags[Index], EWorldCellFlags::Exists) ? 1.0f : 0.0f;
+	}
+}
+
+// ========== 地幔能量交换 ==========
+void WorldMorphingKernels::MantleExchange(const int32* Offsets, const float* ExistsMask, const float* Energy, float* OutEnergy,
+	const FMantleExchangeParams& Params, int32 Begin, int32 Count)
+{
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float Two = VectorSetFloat1(2.0f);
+	const VectorRegister4Float FlowLimit = VectorSetFloat1(2.0f);
+	const VectorRegister4Float NegFlowLimit = VectorSetFloat1(-2.0f);
+	const VectorRegister4Float MaxEnergy = VectorSetFloat1(150.0f);
+	const VectorRegister4Float Coeff = VectorSetFloat1(Params.DiffusionCoeff);
+	const VectorRegister4Float Scale = VectorSetFloat1(0.1f);
+
+	VectorRegister4Float Bias[8];
+	for (int32 i = 0; i < 8; ++i)
+	{
+		Bias[i] = VectorSetFloat1(Params.BiasFlow[i]);
+	}
+
+	const int32 End = Begin + Count;
+	int32 Index = Begin;
+	for (; Index + 4 <= End; Index += 4)
+	{
+		const VectorRegister4Float Self = VectorLoad(Energy + Index);
+
+		VectorRegister4Float Change = Zero;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			const int32 NIndex = Index + Offsets[i];
+
+			// 与标量版本相同的运算顺序: (Diff * Coeff) * 0.1 + Bias
+			const VectorRegister4Float Diff = VectorSubtract(VectorLoad(Energy + NIndex), Self);
+			VectorRegister4Float Flow = VectorAdd(VectorMultiply(VectorMultiply(Diff, Coeff), Scale), Bias[i]);
+			Flow = VectorMin(VectorMax(Flow, NegFlowLimit), FlowLimit);
+
+			// 不存在的邻居贡献为0
+			Change = VectorAdd(Change, VectorMultiply(Flow, VectorLoad(ExistsMask + NIndex)));
+		}
+
+		VectorRegister4Float Next = VectorAdd(Self, VectorMultiply(Two, Change));
+		Next = VectorMin(VectorMax(Next, Zero), MaxEnergy);
+
+		// 不存在的单元格保持原值
+		const VectorRegister4Float SelfExists = VectorCompareGT(VectorLoad(ExistsMask + Index), Zero);
+		VectorStore(VectorSelect(SelfExists, Next, Self), OutEnergy + Index);
+	}
+
+	MantleExchangeScalar(Offsets, ExistsMask, Energy, OutEnergy, Params, Index, End - Index);
+}
+
+void WorldMorphingKernels::MantleExchangeScalar(const int32* Offsets, const float* ExistsMask, const float* Energy, float* OutEnergy,
+	const FMantleExchangeParams& Params, int32 Begin, int32 Count)
+{
+	for (int32 Index = Begin; Index < Begin + Count; ++Index)
+	{
+		if (ExistsMask[Index] == 0.0f)
+		{
+			OutEnergy[Index] = Energy[Index];
+			continue;
+		}
+
+		float Change = 0.0f;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			const int32 NIndex = Index + Offsets[i];
+			if (ExistsMask[NIndex] == 0.0f) continue;
+
+			// 能量差 + 基础扩散 + 迁徙偏置，限制流速
+			float Diff = Energy[NIndex] - Energy[Index];
+			float Flow = Diff * Params.DiffusionCoeff * 0.1f + Params.BiasFlow[i];
+			Change += FMath::Clamp(Flow, -2.0f, 2.0f);
+		}
+
+		// 流量是反对称的（邻居一侧算出的正好是 -Flow），每对邻居从两侧各结算一次，即两倍
+		OutEnergy[Index] = FMath::Clamp(Energy[Index] + 2.0f * Change, 0.0f, 150.0f);
+	}
+}
+
+// ========== 温度扩散 ==========
+void WorldMorphingKernels::DiffuseTemperature(const int32* Offsets, const float* ExistsMask, const float* MantleEnergy, const ECrystalType* CrystalState,
+	const float* Temperature, float* TemperatureChange, float* OutTemperature, const FTemperatureParams& Params, int32 Begin, int32 Count)
+{
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float Relax = VectorSetFloat1(0.1f);
+	const VectorRegister4Float MaxNormalizedEnergy = VectorSetFloat1(100.0f);
+	const VectorRegister4Float EnergyMidpoint = VectorSetFloat1(50.0f);
+	const VectorRegister4Float MinTemperature = VectorSetFloat1(-50.0f);
+	const VectorRegister4Float MaxTemperature = VectorSetFloat1(50.0f);
+	const VectorRegister4Float Seasonal = VectorSetFloat1(Params.SeasonalOffset);
+	const VectorRegister4Float Rate = VectorSetFloat1(Params.DiffusionRate);
+
+	const int32 End = Begin + Count;
+	int32 Index = Begin;
+	for (; Index + 4 <= End; Index += 4)
+	{
+		const VectorRegister4Float Self = VectorLoad(Temperature + Index);
+		const VectorRegister4Float OldChange = VectorLoad(TemperatureChange + Index);
+
+		// 基础温度来自地幔能量
+		const VectorRegister4Float NormalizedEnergy = VectorMin(MaxNormalizedEnergy, VectorLoad(MantleEnergy + Index));
+		const VectorRegister4Float BaseTemperature = VectorAdd(VectorMultiply(VectorSubtract(NormalizedEnergy, EnergyMidpoint), Half), Seasonal);
+
+		// 存在邻居的温度和与数量
+		VectorRegister4Float Sum = Zero;
+		VectorRegister4Float ExistingCount = Zero;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			const int32 NIndex = Index + Offsets[i];
+			const VectorRegister4Float NeighborExists = VectorLoad(ExistsMask + NIndex);
+			Sum = VectorAdd(Sum, VectorMultiply(VectorLoad(Temperature + NIndex), NeighborExists));
+			ExistingCount = VectorAdd(ExistingCount, NeighborExists);
+		}
+
+		// 没有存在邻居时保留上一步的变化量（除零的结果被选择丢弃）
+		const VectorRegister4Float AvgTemp = VectorDivide(Sum, ExistingCount);
+		VectorRegister4Float Change = VectorSelect(VectorCompareGT(ExistingCount, Zero),
+			VectorMultiply(Rate, VectorSubtract(AvgTemp, Self)), OldChange);
+
+		// 晶石的冷却效应
+		Change = VectorSubtract(Change, LoadCrystalCooling(CrystalState + Index));
+
+		// 应用温度变化并向基础温度松弛
+		VectorRegister4Float NewTemperature = VectorAdd(Self, Change);
+		NewTemperature = VectorAdd(NewTemperature, VectorMultiply(VectorSubtract(BaseTemperature, NewTemperature), Relax));
+		NewTemperature = VectorMin(VectorMax(NewTemperature, MinTemperature), MaxTemperature);
+
+		// 不存在的单元格: 温度为 -50，变化量不变
+		const VectorRegister4Float SelfExists = VectorCompareGT(VectorLoad(ExistsMask + Index), Zero);
+		VectorStore(VectorSelect(SelfExists, NewTemperature, MinTemperature), OutTemperature + Index);
+		VectorStore(VectorSelect(SelfExists, Change, OldChange), TemperatureChange + Index);
+	}
+
+	DiffuseTemperatureScalar(Offsets, ExistsMask, MantleEnergy, CrystalState, Temperature, TemperatureChange, OutTemperature, Params, Index, End - Index);
+}
+
+void WorldMorphingKernels::DiffuseTemperatureScalar(const int32* Offsets, const float* ExistsMask, const float* MantleEnergy, const ECrystalType* CrystalState,
+	const float* Temperature, float* TemperatureChange, float* OutTemperature, const FTemperatureParams& Params, int32 Begin, int32 Count)
+{
+	for (int32 Index = Begin; Index < Begin + Count; ++Index)
+	{
+		if (ExistsMask[Index] == 0.0f)
+		{
+			OutTemperature[Index] = -50.0f;
+			continue;
+		}
+
+		// 基础温度来自地幔能量
+		float NormalizedEnergy = FMath::Min(100.0f, MantleEnergy[Index]);
+		float BaseTemperature = (NormalizedEnergy - 50.0f) * 0.5f + Params.SeasonalOffset;
+
+		// 扩散计算
+		float AvgTemp = 0.0f;
+		int32 ExistingCount = 0;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			const int32 NIndex = Index + Offsets[i];
+			if (ExistsMask[NIndex] != 0.0f)
+			{
+				AvgTemp += Temperature[NIndex];
+				ExistingCount++;
+			}
+		}
+
+		if (ExistingCount > 0)
+		{
+			AvgTemp /= ExistingCount;
+			TemperatureChange[Index] = Params.DiffusionRate * (AvgTemp - Temperature[Index]);
+		}
+
+		// 晶石的冷却效应
+		TemperatureChange[Index] -= GetCrystalCooling(CrystalState[Index]);
+
+		// 应用温度变化
+		float NewTemperature = Temperature[Index] + TemperatureChange[Index];
+		NewTemperature += (BaseTemperature - NewTemperature) * 0.1f;
+
+		// 温度限制
+		OutTemperature[Index] = FMath::Clamp(NewTemperature, -50.0f, 50.0f);
+	}
+}
+
+// ========== 雷暴判定 ==========
+void WorldMorphingKernels::UpdateThunderstorms(const int32* Offsets, const float* ExistsMask, const float* Temperature,
+	const EWorldCellFlags* Flags, EWorldCellFlags* OutFlags, float Threshold, int32 Begin, int32 Count)
+{
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float VThreshold = VectorSetFloat1(Threshold);
+
+	const int32 End = Begin + Count;
+	int32 Index = Begin;
+	for (; Index + 4 <= End; Index += 4)
+	{
+		const VectorRegister4Float Self = VectorLoad(Temperature + Index);
+
+		// 不存在的邻居温差记为0，不影响最大值
+		VectorRegister4Float MaxDiff = Zero;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			const int32 NIndex = Index + Offsets[i];
+			const VectorRegister4Float Diff = VectorAbs(VectorSubtract(VectorLoad(Temperature + NIndex), Self));
+			MaxDiff = VectorMax(MaxDiff, VectorMultiply(Diff, VectorLoad(ExistsMask + NIndex)));
+		}
+
+		const uint32 StormBits = VectorMaskBits(VectorCompareGT(MaxDiff, VThreshold));
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const int32 CellIndex = Index + Lane;
+			const bool bThunderstorm = (StormBits & (1u << Lane)) != 0 && ExistsMask[CellIndex] != 0.0f;
+			OutFlags[CellIndex] = bThunderstorm
+				? (Flags[CellIndex] | EWorldCellFlags::Thunderstorm)
+				: (Flags[CellIndex] & ~EWorldCellFlags::Thunderstorm);
+		}
+	}
+
+	UpdateThunderstormsScalar(Offsets, ExistsMask, Temperature, Flags, OutFlags, Threshold, Index, End - Index);
+}
+
+void WorldMorphingKernels::UpdateThunderstormsScalar(const int32* Offsets, const float* ExistsMask, const float* Temperature,
+	const EWorldCellFlags* Flags, EWorldCellFlags* OutFlags, float Threshold, int32 Begin, int32 Count)
+{
+	for (int32 Index = Begin; Index < Begin + Count; ++Index)
+	{
+		bool bThunderstorm = false;
+		if (ExistsMask[Index] != 0.0f)
+		{
+			float MaxDiff = 0.0f;
+			for (int32 i = 0; i < 8; ++i)
+			{
+				const int32 NIndex = Index + Offsets[i];
+				if (ExistsMask[NIndex] != 0.0f)
+				{
+					MaxDiff = FMath::Max(MaxDiff, FMath::Abs(Temperature[NIndex] - Temperature[Index]));
+				}
+			}
+			bThunderstorm = MaxDiff > Threshold;
+		}
+
+		OutFlags[Index] = bThunderstorm
+			? (Flags[Index] | EWorldCellFlags::Thunderstorm)
+			: (Flags[Index] & ~EWorldCellFlags::Thunderstorm);
+	}
+}
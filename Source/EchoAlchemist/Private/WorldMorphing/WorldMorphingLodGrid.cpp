@@ -0,0 +1,170 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingLodGrid.h"
+#include "Async/ParallelFor.h"
+
+void FWorldMorphingLodGrid::Init(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(0, InWidth);
+	Height = FMath::Max(0, InHeight);
+	TilesX = FMath::DivideAndRoundUp(Width, TileSize);
+	TilesY = FMath::DivideAndRoundUp(Height, TileSize);
+
+	for (int32 Lod = 1; Lod <= NumLevels; ++Lod)
+	{
+		const int32 Factor = GetFactor(Lod);
+		Levels[Lod - 1].Init(FMath::DivideAndRoundUp(Width, Factor), FMath::DivideAndRoundUp(Height, Factor));
+	}
+
+	TileHadLand.Init(0, TilesX * TilesY);
+	TileDirty.Init(1, TilesX * TilesY);
+}
+
+void FWorldMorphingLodGrid::Reset()
+{
+	Width = 0;
+	Height = 0;
+	TilesX = 0;
+	TilesY = 0;
+	for (FWorldMorphingGrid& Level : Levels)
+	{
+		Level.Empty();
+	}
+	TileHadLand.Empty();
+	TileDirty.Empty();
+}
+
+void FWorldMorphingLodGrid::MarkAllDirty()
+{
+	FMemory::Memset(TileDirty.GetData(), 1, TileDirty.Num());
+}
+
+int32 FWorldMorphingLodGrid::Update(const FWorldMorphingGrid& Grid)
+{
+	check(Grid.Width == Width && Grid.Height == Height);
+
+	// 每一行块独立写入各层级中互不重叠的行
+	TArray<int32> RowRebuilt;
+	RowRebuilt.Init(0, TilesY);
+	ParallelFor(TilesY, [this, &Grid, &RowRebuilt](int32 TileY)
+	{
+		for (int32 TileX = 0; TileX < TilesX; ++TileX)
+		{
+			const int32 Tile = TileY * TilesX + TileX;
+			const bool bHasLand = TileHasLand(Grid, TileX, TileY);
+			if (!TileDirty[Tile] && !bHasLand && !TileHadLand[Tile]) continue;
+
+			TileDirty[Tile] = 0;
+			TileHadLand[Tile] = bHasLand ? 1 : 0;
+			RowRebuilt[TileY]++;
+
+			for (int32 Lod = 1; Lod <= NumLevels; ++Lod)
+			{
+				FWorldMorphingGrid& Level = Levels[Lod - 1];
+				const int32 Factor = GetFactor(Lod);
+				const int32 BeginX = TileX * TileSize / Factor;
+				const int32 BeginY = TileY * TileSize / Factor;
+				const int32 EndX = FMath::Min(BeginX + TileSize / Factor, Level.Width);
+				const int32 EndY = FMath::Min(BeginY + TileSize / Factor, Level.Height);
+
+				for (int32 LodY = BeginY; LodY < EndY; ++LodY)
+				{
+					for (int32 LodX = BeginX; LodX < EndX; ++LodX)
+					{
+						ReduceBlock(Grid, Factor, LodX, LodY, Level);
+					}
+				}
+			}
+		}
+	});
+
+	int32 Rebuilt = 0;
+	for (int32 Count : RowRebuilt)
+	{
+		Rebuilt += Count;
+	}
+	return Rebuilt;
+}
+
+bool FWorldMorphingLodGrid::TileHasLand(const FWorldMorphingGrid& Grid, int32 TileX, int32 TileY) const
+{
+	const int32 BeginX = TileX * TileSize;
+	const int32 EndX = FMath::Min(BeginX + TileSize, Width);
+	const int32 EndY = FMath::Min((TileY + 1) * TileSize, Height);
+
+	for (int32 Y = TileY * TileSize; Y < EndY; ++Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		for (int32 X = BeginX; X < EndX; ++X)
+		{
+			if (Grid.Exists(RowStart + X))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void FWorldMorphingLodGrid::ReduceBlock(const FWorldMorphingGrid& Grid, int32 Factor, int32 LodX, int32 LodY, FWorldMorphingGrid& OutLevel)
+{
+	constexpr int32 NumFields = static_cast<int32>(EWorldMorphingField::Count);
+	constexpr int32 NumCrystalTypes = static_cast<int32>(ECrystalType::Human) + 1;
+
+	int32 ValidCells = 0;
+	int32 LandCells = 0;
+	int32 StormCells = 0;
+	int32 AbsorbingCells = 0;
+	int32 CrystalCounts[NumCrystalTypes] = {};
+	double Sums[NumFields] = {};
+	float MaxProsperity = 0.0f;
+
+	const int32 EndX = FMath::Min((LodX + 1) * Factor, Grid.Width);
+	const int32 EndY = FMath::Min((LodY + 1) * Factor, Grid.Height);
+	for (int32 Y = LodY * Factor; Y < EndY; ++Y)
+	{
+		for (int32 X = LodX * Factor; X < EndX; ++X)
+		{
+			const int32 Index = Grid.ToIndex(X, Y);
+			ValidCells++;
+			if (!Grid.Exists(Index)) continue;
+
+			LandCells++;
+			StormCells += Grid.HasFlag(Index, EWorldCellFlags::Thunderstorm) ? 1 : 0;
+			AbsorbingCells += Grid.HasFlag(Index, EWorldCellFlags::Absorbing) ? 1 : 0;
+			CrystalCounts[static_cast<int32>(Grid.CrystalState[Index])]++;
+			for (int32 Field = 0; Field < NumFields; ++Field)
+			{
+				Sums[Field] += Grid.GetField(static_cast<EWorldMorphingField>(Field))[Index];
+			}
+			MaxProsperity = FMath::Max(MaxProsperity, Grid.Prosperity[Index]);
+		}
+	}
+
+	const int32 OutIndex = OutLevel.ToIndex(LodX, LodY);
+	EWorldCellFlags Flags = EWorldCellFlags::Valid;
+	if (LandCells * 2 >= ValidCells && LandCells > 0) Flags |= EWorldCellFlags::Exists;
+	if (LandCells > 0 && StormCells * 2 >= LandCells) Flags |= EWorldCellFlags::Thunderstorm;
+	if (LandCells > 0 && AbsorbingCells * 2 >= LandCells) Flags |= EWorldCellFlags::Absorbing;
+	OutLevel.Flags[OutIndex] = Flags;
+
+	for (int32 Field = 0; Field < NumFields; ++Field)
+	{
+		OutLevel.GetField(static_cast<EWorldMorphingField>(Field))[OutIndex] = LandCells > 0 ? static_cast<float>(Sums[Field] / LandCells) : 0.0f;
+	}
+	OutLevel.Prosperity[OutIndex] = MaxProsperity;
+
+	// 多数晶石状态（从高到低遍历，并列时取非空的类型）
+	ECrystalType Majority = ECrystalType::Empty;
+	int32 MajorityCount = 0;
+	for (int32 Type = NumCrystalTypes - 1; Type >= 0; --Type)
+	{
+		if (CrystalCounts[Type] > MajorityCount)
+		{
+			Majority = static_cast<ECrystalType>(Type);
+			MajorityCount = CrystalCounts[Type];
+		}
+	}
+	OutLevel.CrystalState[OutIndex] = Majority;
+}
@@ -0,0 +1,275 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingSaveFormat.h"
+#include "Async/ParallelFor.h"
+#include "Math/Float16.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	// 压缩方式
+	constexpr uint8 CodecNone = 0;
+	constexpr uint8 CodecOodle = 1;
+
+	// 尺寸和供给点数量的合理上限（拒绝损坏的存档头；平面字节数另外检查不超过 int32 范围）
+	constexpr int32 MaxDimension = 16384;
+	constexpr int32 MaxSupplyPoints = 4096;
+
+	// 半精度字段数量（平面顺序同 EWorldMorphingField）
+	constexpr int32 NumHalfFields = static_cast<int32>(EWorldMorphingField::Count);
+
+	void SerializeHeader(FArchive& Ar, FWorldMorphingSaveHeader& Header)
+	{
+		Ar << Header.Width << Header.Height << Header.bDelta;
+		Ar << Header.TimeStep << Header.CycleCount << Header.Seed << Header.RandomState;
+		Ar << Header.NoiseOffsetX << Header.NoiseOffsetY;
+
+		int32 NumPoints = Header.EdgeSupplyPoints.Num();
+		Ar << NumPoints;
+		if (Ar.IsLoading())
+		{
+			if (NumPoints < 0 || NumPoints > MaxSupplyPoints)
+			{
+				Ar.SetError();
+				return;
+			}
+			Header.EdgeSupplyPoints.SetNum(NumPoints);
+		}
+		for (FEdgeSupplyPoint& Point : Header.EdgeSupplyPoints)
+		{
+			Ar << Point.Angle << Point.Speed;
+		}
+	}
+}
+
+int32 FWorldMorphingSaveFormat::GetPlaneSize(int32 Width, int32 Height)
+{
+	if (Width <= 0 || Height <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int64 Size = static_cast<int64>(Width) * Height * BytesPerCell;
+	return Size <= MAX_int32 ? static_cast<int32>(Size) : INDEX_NONE;
+}
+
+bool FWorldMorphingSaveFormat::QuantizePlanes(const FWorldMorphingGrid& Grid, TArray<uint8>& OutPlanes)
+{
+	// 平面字节数在 int32 范围内时，下面所有的平面偏移也在范围内
+	const int32 PlaneSize = GetPlaneSize(Grid.Width, Grid.Height);
+	if (PlaneSize == INDEX_NONE)
+	{
+		OutPlanes.Reset();
+		return false;
+	}
+
+	const int32 Width = Grid.Width;
+	const int32 NumCells = Grid.Width * Grid.Height;
+	OutPlanes.SetNumUninitialized(PlaneSize);
+	uint8* Planes = OutPlanes.GetData();
+
+	ParallelFor(Grid.Height, [&Grid, Planes, Width, NumCells](int32 Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		const int32 Cell = Y * Width;
+
+		for (int32 X = 0; X < Width; ++X)
+		{
+			Planes[Cell + X] = static_cast<uint8>(Grid.Flags[RowStart + X]);
+			Planes[NumCells + Cell + X] = static_cast<uint8>(Grid.CrystalState[RowStart + X]);
+		}
+
+		for (int32 Field = 0; Field < NumHalfFields; ++Field)
+		{
+			const float* Values = Grid.GetField(static_cast<EWorldMorphingField>(Field)).GetData() + RowStart;
+			uint8* Low = Planes + (2 + Field * 2) * NumCells + Cell;
+			uint8* High = Low + NumCells;
+			for (int32 X = 0; X < Width; ++X)
+			{
+				const FFloat16 Half(Values[X]);
+				Low[X] = static_cast<uint8>(Half.Encoded & 0xFF);
+				High[X] = static_cast<uint8>(Half.Encoded >> 8);
+			}
+		}
+	});
+
+	return true;
+}
+
+bool FWorldMorphingSaveFormat::DequantizePlanes(TConstArrayView<uint8> Planes, int32 Width, int32 Height, FWorldMorphingGrid& OutGrid)
+{
+	const int32 PlaneSize = GetPlaneSize(Width, Height);
+	if (PlaneSize == INDEX_NONE || Planes.Num() != PlaneSize)
+	{
+		return false;
+	}
+
+	const int32 NumCells = Width * Height;
+
+	OutGrid.Init(Width, Height);
+	const uint8* Data = Planes.GetData();
+	ParallelFor(Height, [&OutGrid, Data, Width, NumCells](int32 Y)
+	{
+		const int32 RowStart = OutGrid.ToIndex(0, Y);
+		const int32 Cell = Y * Width;
+
+		for (int32 X = 0; X < Width; ++X)
+		{
+			OutGrid.Flags[RowStart + X] = static_cast<EWorldCellFlags>(Data[Cell + X]);
+			OutGrid.CrystalState[RowStart + X] = static_cast<ECrystalType>(Data[NumCells + Cell + X]);
+		}
+
+		for (int32 Field = 0; Field < NumHalfFields; ++Field)
+		{
+			float* Values = OutGrid.GetField(static_cast<EWorldMorphingField>(Field)).GetData() + RowStart;
+			const uint8* Low = Data + (2 + Field * 2) * NumCells + Cell;
+			const uint8* High = Low + NumCells;
+			for (int32 X = 0; X < Width; ++X)
+			{
+				FFloat16 Half;
+				Half.Encoded = static_cast<uint16>(Low[X] | (High[X] << 8));
+				Values[X] = Half.GetFloat();
+			}
+		}
+	});
+
+	return true;
+}
+
+void FWorldMorphingSaveFormat::Save(const FWorldMorphingSaveHeader& Header, TConstArrayView<uint8> Planes, TConstArrayView<uint8> KeyframePlanes, TArray<uint8>& OutData)
+{
+	check(Planes.Num() == GetPlaneSize(Header.Width, Header.Height));
+
+	FWorldMorphingSaveHeader FileHeader = Header;
+	FileHeader.bDelta = KeyframePlanes.Num() > 0;
+
+	// 增量存档: 与关键帧异或
+	TArray<uint8> Encoded(Planes.GetData(), Planes.Num());
+	uint32 KeyframeCrc = 0;
+	if (FileHeader.bDelta)
+	{
+		check(KeyframePlanes.Num() == Planes.Num());
+		XorPlanes(Encoded, KeyframePlanes);
+		KeyframeCrc = FCrc::MemCrc32(KeyframePlanes.GetData(), KeyframePlanes.Num());
+	}
+
+	// 压缩失败（或压缩后更大）时直接存储
+	uint8 Codec = CodecOodle;
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, Encoded.Num());
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Oodle, Compressed.GetData(), CompressedSize, Encoded.GetData(), Encoded.Num(), COMPRESS_BiasSpeed)
+		|| CompressedSize >= Encoded.Num())
+	{
+		Codec = CodecNone;
+		Compressed = MoveTemp(Encoded);
+		CompressedSize = Compressed.Num();
+	}
+	Compressed.SetNum(CompressedSize, EAllowShrinking::No);
+
+	OutData.Reset();
+	FMemoryWriter Writer(OutData);
+
+	uint32 FileMagic = Magic;
+	int32 FileVersion = Version;
+	Writer << FileMagic << FileVersion;
+	SerializeHeader(Writer, FileHeader);
+
+	int32 PlaneSize = Planes.Num();
+	Writer << KeyframeCrc << Codec << PlaneSize << CompressedSize;
+	Writer.Serialize(Compressed.GetData(), CompressedSize);
+}
+
+bool FWorldMorphingSaveFormat::Load(TConstArrayView<uint8> Data, TConstArrayView<uint8> KeyframePlanes, FWorldMorphingSaveHeader& OutHeader, TArray<uint8>& OutPlanes)
+{
+	FMemoryReaderView Reader(Data);
+
+	uint32 FileMagic = 0;
+	int32 FileVersion = 0;
+	Reader << FileMagic << FileVersion;
+	if (Reader.IsError() || FileMagic != Magic || FileVersion != Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WorldMorphing save: unknown format (magic 0x%08x, version %d)"), FileMagic, FileVersion);
+		return false;
+	}
+
+	FWorldMorphingSaveHeader Header;
+	SerializeHeader(Reader, Header);
+
+	uint32 KeyframeCrc = 0;
+	uint8 Codec = CodecNone;
+	int32 PlaneSize = 0;
+	int32 CompressedSize = 0;
+	Reader << KeyframeCrc << Codec << PlaneSize << CompressedSize;
+
+	if (Reader.IsError()
+		|| Header.Width <= 0 || Header.Width > MaxDimension || Header.Height <= 0 || Header.Height > MaxDimension
+		|| GetPlaneSize(Header.Width, Header.Height) == INDEX_NONE
+		|| PlaneSize != GetPlaneSize(Header.Width, Header.Height)
+		|| CompressedSize < 0 || CompressedSize > Reader.TotalSize() - Reader.Tell())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WorldMorphing save: corrupt header"));
+		return false;
+	}
+
+	if (Header.bDelta
+		&& (KeyframePlanes.Num() != PlaneSize || FCrc::MemCrc32(KeyframePlanes.GetData(), KeyframePlanes.Num()) != KeyframeCrc))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WorldMorphing save: delta does not match the current keyframe"));
+		return false;
+	}
+
+	const uint8* Payload = Data.GetData() + Reader.Tell();
+	OutPlanes.SetNumUninitialized(PlaneSize);
+	if (Codec == CodecOodle)
+	{
+		if (!FCompression::UncompressMemory(NAME_Oodle, OutPlanes.GetData(), PlaneSize, Payload, CompressedSize))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("WorldMorphing save: decompression failed"));
+			return false;
+		}
+	}
+	else if (Codec == CodecNone && CompressedSize == PlaneSize)
+	{
+		FMemory::Memcpy(OutPlanes.GetData(), Payload, PlaneSize);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WorldMorphing save: unknown codec %d"), Codec);
+		return false;
+	}
+
+	if (Header.bDelta)
+	{
+		XorPlanes(OutPlanes, KeyframePlanes);
+	}
+
+	OutHeader = MoveTemp(Header);
+	return true;
+}
+
+void FWorldMorphingSaveFormat::XorPlanes(TArrayView<uint8> Planes, TConstArrayView<uint8> KeyframePlanes)
+{
+	uint8* Data = Planes.GetData();
+	const uint8* Keyframe = KeyframePlanes.GetData();
+	const int32 Num = Planes.Num();
+
+	// 按8字节异或，尾部逐字节
+	int32 Index = 0;
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		uint64 Value;
+		uint64 Key;
+		FMemory::Memcpy(&Value, Data + Index, 8);
+		FMemory::Memcpy(&Key, Keyframe + Index, 8);
+		Value ^= Key;
+		FMemory::Memcpy(Data + Index, &Value, 8);
+	}
+	for (; Index < Num; ++Index)
+	{
+		Data[Index] ^= Keyframe[Index];
+	}
+}
@@ -0,0 +1,1050 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingSim.h"
+#include "WorldMorphing/WorldMorphingKernels.h"
+#include "WorldMorphing/WorldMorphingChunkedGrid.h"
+#include "WorldMorphing/WorldMorphingSaveFormat.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	// 随机阶段编号（用于派生计数器随机数）
+	constexpr int32 StageMantleEdge = 1;
+	constexpr int32 StageCrystalTransition = 2;
+	constexpr int32 StageHumanUpdate = 3;
+	constexpr int32 StageSupplyJitter = 4;
+	constexpr int32 StageInitialEnergy = 5;
+	
+	// 径向掩码位
+	constexpr uint8 RadialWithinMaxRadius = 1 << 0;   // 到中心的距离不超过 MaxRadius（可以扩张到这里）
+	constexpr uint8 RadialBeyondMinRadius = 1 << 1;   // 到中心的距离超过 MinRadius（可以缩减）
+	
+	// 人类层提议编码：三个目标各占4位（邻居槽位 + 1，0 表示没有），另有来源和死亡标志
+	constexpr int32 HumanMineShift = 0;
+	constexpr int32 HumanExpandShift = 4;
+	constexpr int32 HumanMigrateShift = 8;
+	constexpr uint32 HumanProposalSource = 1u << 12;
+	constexpr uint32 HumanProposalDies = 1u << 13;
+	
+	FORCEINLINE uint32 EncodeHumanSlot(int32 Slot, int32 Shift)
+	{
+		return static_cast<uint32>(Slot + 1) << Shift;
+	}
+	
+	FORCEINLINE int32 DecodeHumanSlot(uint32 Proposal, int32 Shift)
+	{
+		return static_cast<int32>((Proposal >> Shift) & 0xF) - 1;
+	}
+	
+	// 相反方向的邻居槽位（NeighborOffsets[7 - i] == -NeighborOffsets[i]）
+	FORCEINLINE int32 OppositeSlot(int32 Slot)
+	{
+		return 7 - Slot;
+	}
+}
+
+void FWorldMorphingSim::Initialize(int32 InWidth, int32 InHeight, const FSimulationParams& InitParams)
+{
+	Width = InWidth;
+	Height = InHeight;
+	Params = InitParams;
+	TimeStep = 0;
+	CycleCount = 0;
+	LayerTimings = FWorldMorphingLayerTimings();
+	
+	// 初始化随机流
+	Seed = Params.RandomSeed != 0 ? Params.RandomSeed : FMath::Rand();
+	RandomStream.Initialize(Seed);
+	
+	// 初始化噪声偏移
+	NoiseOffsetX = RandomStream.FRand() * 1000.0f;
+	NoiseOffsetY = RandomStream.FRand() * 1000.0f;
+	
+	// 初始化边缘供给点
+	EdgeSupplyPoints.Empty();
+	for (int32 i = 0; i < Params.EdgeSupplyPointCount; ++i)
+	{
+		float Angle = RandomStream.FRand() * PI * 2.0f;
+		float Speed = (RandomStream.FRand() - 0.5f) * Params.EdgeSupplyPointSpeed;
+		EdgeSupplyPoints.Add(FEdgeSupplyPoint(Angle, Speed));
+	}
+	
+	// 初始化网格
+	Grid.Init(Width, Height);
+	ResetDerivedState();
+	const float InitialRadius = FMath::Min(Width, Height) * 0.4f;
+	
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const int32 Index = Grid.ToIndex(X, Y);
+			
+			// 到中心的距离（几何缓存）
+			const float Dist = CellRadii[Index];
+			
+			if (Dist < InitialRadius)
+			{
+				Grid.SetFlag(Index, EWorldCellFlags::Exists, true);
+				Grid.MantleEnergy[Index] = 50.0f + MakeCellRandom(StageInitialEnergy, Index).FRand() * 20.0f;
+				
+				// 中心区域初始化Alpha晶石
+				if (Dist < 3.0f)
+				{
+					Grid.CrystalState[Index] = ECrystalType::Alpha;
+				}
+			}
+		}
+	}
+	
+	Statistics.Recompute(Grid);
+	
+	UE_LOG(LogTemp, Log, TEXT("World Initialized: %dx%d (Seed %d)"), Width, Height, Seed);
+}
+
+void FWorldMorphingSim::Empty()
+{
+	Width = 0;
+	Height = 0;
+	TimeStep = 0;
+	CycleCount = 0;
+	Grid.Empty();
+	BackGrid.Empty();
+	ExistsMask.Empty();
+	CellAngles.Empty();
+	CellRadii.Empty();
+	RadialMask.Empty();
+	EdgeSupplyPoints.Empty();
+	EdgeDistance.Reset();
+	CrystalActivity.Reset();
+	HumanActivity.Reset();
+	HumanProposals.Empty();
+	HumanProposedProsperity.Empty();
+	HumanArrivals.Empty();
+	Statistics.Reset();
+	LayerTimings = FWorldMorphingLayerTimings();
+}
+
+void FWorldMorphingSim::Step()
+{
+	TimeStep++;
+	if (TimeStep % 1000 == 0)
+	{
+		CycleCount++;
+	}
+	
+	// 更新各层（逐层计时）
+	uint64 Cycles = FPlatformTime::Cycles64();
+	auto LapSeconds = [&Cycles]()
+	{
+		const uint64 Now = FPlatformTime::Cycles64();
+		const double Seconds = FPlatformTime::ToSeconds64(Now - Cycles);
+		Cycles = Now;
+		return Seconds;
+	};
+	
+	UpdateMantleLayer();
+	LayerTimings.MantleSeconds += LapSeconds();
+	UpdateClimateLayer();
+	LayerTimings.ClimateSeconds += LapSeconds();
+	UpdateCrystalLayer();
+	LayerTimings.CrystalSeconds += LapSeconds();
+	UpdateHumanLayer();
+	LayerTimings.HumanSeconds += LapSeconds();
+	LayerTimings.Steps++;
+	
+	// 定期全量重新计算，修正增量统计的累积误差
+	if (TimeStep % StatisticsRecomputeInterval == 0)
+	{
+		Statistics.Recompute(Grid);
+	}
+}
+
+void FWorldMorphingSim::RestoreState(const FWorldMorphingSaveHeader& Header, FWorldMorphingGrid&& InGrid)
+{
+	Width = Header.Width;
+	Height = Header.Height;
+	TimeStep = Header.TimeStep;
+	CycleCount = Header.CycleCount;
+	Seed = Header.Seed;
+	RandomStream.Initialize(Header.RandomState);
+	NoiseOffsetX = Header.NoiseOffsetX;
+	NoiseOffsetY = Header.NoiseOffsetY;
+	EdgeSupplyPoints = Header.EdgeSupplyPoints;
+	Grid = MoveTemp(InGrid);
+	ResetDerivedState();
+}
+
+void FWorldMorphingSim::ImportChunks(const FWorldMorphingChunkedGrid& Chunks)
+{
+	Width = Chunks.GetWidth();
+	Height = Chunks.GetHeight();
+	Chunks.ToGrid(Grid);
+	ResetDerivedState();
+}
+
+void FWorldMorphingSim::ResetDerivedState()
+{
+	BackGrid.Init(Width, Height);
+	ExistsMask.Init(0.0f, Grid.Num());
+	EdgeDistance.Reset();
+	CrystalActivity.Init(Width, Height);
+	HumanActivity.Init(Width, Height);
+	HumanProposals.Init(0, Grid.Num());
+	HumanProposedProsperity.Init(0.0f, Grid.Num());
+	HumanArrivals.Init(0, Grid.Num());
+	BuildGeometryCache();
+	Statistics.Recompute(Grid);
+}
+
+bool FWorldMorphingSim::IsValidCoord(int32 X, int32 Y) const
+{
+	return X >= 0 && X < Width && Y >= 0 && Y < Height;
+}
+
+int32 FWorldMorphingSim::GetNumBands() const
+{
+	return (Height + RowsPerBand - 1) / RowsPerBand;
+}
+
+void FWorldMorphingSim::ParallelForBands(TFunctionRef<void(int32 Band, int32 BeginIndex, int32 EndIndex)> Body) const
+{
+	const EParallelForFlags ForFlags = bUseMultithreading ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+	
+	ParallelFor(GetNumBands(), [this, &Body](int32 Band)
+	{
+		const int32 RowBegin = Band * RowsPerBand;
+		const int32 RowEnd = FMath::Min(RowBegin + RowsPerBand, Height);
+		
+		// 下标范围包含行间的光晕列，调用方按 IsValid/Exists 跳过
+		Body(Band, Grid.ToIndex(0, RowBegin), Grid.ToIndex(0, RowEnd));
+	}, ForFlags);
+}
+
+void FWorldMorphingSim::RefreshExistsMask()
+{
+	ParallelForBands([this](int32 Band, int32 BeginIndex, int32 EndIndex)
+	{
+		for (int32 RowStart = BeginIndex; RowStart < EndIndex; RowStart += Grid.Pitch)
+		{
+			WorldMorphingKernels::BuildExistsMask(Grid.Flags.GetData(), ExistsMask.GetData(), RowStart, Width);
+		}
+	});
+}
+
+void FWorldMorphingSim::BuildGeometryCache()
+{
+	const float CenterX = Width / 2.0f;
+	const float CenterY = Height / 2.0f;
+	
+	CellAngles.Init(0.0f, Grid.Num());
+	CellRadii.Init(0.0f, Grid.Num());
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const int32 Index = Grid.ToIndex(X, Y);
+			float Angle = FMath::Atan2(Y - CenterY, X - CenterX);
+			if (Angle < 0.0f) Angle += PI * 2.0f;
+			CellAngles[Index] = Angle;
+			CellRadii[Index] = FMath::Sqrt(FMath::Square(X - CenterX) + FMath::Square(Y - CenterY));
+		}
+	}
+	
+	// 半径改变后径向掩码需要重建
+	RadialMask.Init(0, Grid.Num());
+	RadialMaskMaxRadius = -1.0f;
+	RadialMaskMinRadius = -1.0f;
+}
+
+void FWorldMorphingSim::RefreshRadialMask()
+{
+	if (RadialMaskMaxRadius == Params.MaxRadius && RadialMaskMinRadius == Params.MinRadius)
+	{
+		return;
+	}
+	
+	RadialMaskMaxRadius = Params.MaxRadius;
+	RadialMaskMinRadius = Params.MinRadius;
+	
+	// 光晕保持为0（光晕单元格不会成为扩张目标）
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		for (int32 Index = RowStart; Index < RowStart + Width; ++Index)
+		{
+			RadialMask[Index] = (CellRadii[Index] <= Params.MaxRadius ? RadialWithinMaxRadius : 0)
+				| (CellRadii[Index] > Params.MinRadius ? RadialBeyondMinRadius : 0);
+		}
+	}
+}
+
+void FWorldMorphingSim::BuildActivityTiles(TArray<uint8>& OutTiles) const
+{
+	const int32 TilesX = CrystalActivity.GetTilesX();
+	const int32 TilesY = CrystalActivity.GetTilesY();
+	
+	OutTiles.SetNumUninitialized(TilesX * TilesY);
+	for (int32 TileY = 0; TileY < TilesY; ++TileY)
+	{
+		for (int32 TileX = 0; TileX < TilesX; ++TileX)
+		{
+			OutTiles[TileY * TilesX + TileX] = (CrystalActivity.IsProcessed(TileX, TileY) ? 1 : 0)
+				| (HumanActivity.IsProcessed(TileX, TileY) ? 2 : 0);
+		}
+	}
+}
+
+FWorldMorphingCellRandom FWorldMorphingSim::MakeCellRandom(int32 Stage, int32 Key) const
+{
+	return FWorldMorphingCellRandom(Seed, TimeStep, Stage, Key);
+}
+
+// ========== 地幔层更新 ==========
+void FWorldMorphingSim::UpdateMantleLayer()
+{
+	const int32* Offsets = Grid.NeighborOffsets;
+	
+	// 1. Cahn-Hilliard 相分离 + 扩散（汇聚形式: 读取 Grid，写入 BackGrid）
+	{
+		const float DiffusionCoeff = 0.2f;
+		
+		// 缓慢迁徙偏置
+		const float Time = TimeStep * Params.MantleTimeScale;
+		const float BiasX = FMath::Sin(Time * 0.5f);
+		const float BiasY = FMath::Cos(Time * 0.5f);
+		
+		// 每个邻居方向的偏置流量只取决于方向
+		WorldMorphingKernels::FMantleExchangeParams ExchangeParams;
+		ExchangeParams.DiffusionCoeff = DiffusionCoeff;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			ExchangeParams.BiasFlow[i] = (FWorldMorphingGrid::NeighborDX[i] * BiasX + FWorldMorphingGrid::NeighborDY[i] * BiasY) * 0.05f;
+		}
+		
+		const float* MantleEnergy = Grid.MantleEnergy.GetData();
+		float* NextMantleEnergy = BackGrid.MantleEnergy.GetData();
+		
+		RefreshExistsMask();
+		
+		ParallelForBands([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			// 逐行调用SIMD内核（光晕列不变，前后缓冲中保持一致）
+			for (int32 RowStart = BeginIndex; RowStart < EndIndex; RowStart += Grid.Pitch)
+			{
+				WorldMorphingKernels::MantleExchange(Offsets, ExistsMask.GetData(), MantleEnergy, NextMantleEnergy, ExchangeParams, RowStart, Width);
+			}
+		});
+		
+		Swap(Grid.MantleEnergy, BackGrid.MantleEnergy);
+	}
+	
+	// 2. 边缘能量生成机制
+	// 更新供给点位置
+	for (int32 PointIndex = 0; PointIndex < EdgeSupplyPoints.Num(); ++PointIndex)
+	{
+		FEdgeSupplyPoint& Point = EdgeSupplyPoints[PointIndex];
+		FWorldMorphingCellRandom Random = MakeCellRandom(StageSupplyJitter, PointIndex);
+		
+		Point.Angle += Point.Speed * (Random.FRand() * 0.5f + 0.75f);
+		if (Point.Angle > PI * 2.0f) Point.Angle -= PI * 2.0f;
+		if (Point.Angle < 0.0f) Point.Angle += PI * 2.0f;
+		
+		// 偶尔改变速度方向
+		if (Random.FRand() < 0.01f)
+		{
+			Point.Speed = (Random.FRand() - 0.5f) * Params.EdgeSupplyPointSpeed;
+		}
+	}
+	
+	if (Params.EdgeGenerationEnergy > 0.0f)
+	{
+		// 每步根据供给点重建角度密度表，单元格只查表
+		SupplyDensity.Build(EdgeSupplyPoints, Params.EdgeGenerationWidth * 0.15f);
+		
+		// 到边缘的距离场：首次使用或参数改变时重建，之后随地形变化增量修复
+		const int32 MaxDist = Params.EdgeGenerationOffset + Params.EdgeGenerationWidth + 1;
+		if (!EdgeDistance.IsBuiltFor(Grid, MaxDist))
+		{
+			EdgeDistance.Rebuild(Grid, MaxDist);
+		}
+		
+		// 应用能量供给（只写自身，原地并行）
+		float* MantleEnergy = Grid.MantleEnergy.GetData();
+		ParallelForBands([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			for (int32 Index = BeginIndex; Index < EndIndex; ++Index)
+			{
+				if (!Grid.Exists(Index)) continue;
+				
+				int32 Dist = EdgeDistance.GetDistance(Index);
+				
+				// 判断是否在生成范围内
+				if (Dist >= Params.EdgeGenerationOffset && Dist < Params.EdgeGenerationOffset + Params.EdgeGenerationWidth)
+				{
+					// 应用能量供给
+					MantleEnergy[Index] += Params.EdgeGenerationEnergy * SupplyDensity.Sample(CellAngles[Index]);
+				}
+			}
+		});
+	}
+	
+	// 3. 边缘扩张/缩减逻辑
+	// 各条带基于本阶段开始时的状态并行提出事件，再按条带顺序串行应用（冲突时先到先得）
+	struct FEdgeEvent
+	{
+		int32 Index;
+		int32 Target; // 扩张目标，INDEX_NONE 表示缩减
+	};
+	
+	TArray<TArray<FEdgeEvent>> BandEvents;
+	BandEvents.SetNum(GetNumBands());
+	
+	{
+		const float* MantleEnergy = Grid.MantleEnergy.GetData();
+		
+		// 扩张和缩减的半径限制只查表（参数中的半径改变时重建）
+		RefreshRadialMask();
+		const uint8* Radial = RadialMask.GetData();
+		
+		ParallelForBands([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			TArray<FEdgeEvent>& Events = BandEvents[Band];
+			
+			for (int32 Index = BeginIndex; Index < EndIndex; ++Index)
+			{
+				if (!Grid.Exists(Index)) continue;
+				
+				// 网格内不存在的邻居（光晕不计入）
+				const uint8 OpenMask = Grid.GetNeighborMask(Index, EWorldCellFlags::Valid) & ~Grid.GetNeighborMask(Index, EWorldCellFlags::Exists);
+				if (OpenMask == 0) continue;
+				
+				// 扩张逻辑
+				if (MantleEnergy[Index] > Params.ExpansionThreshold)
+				{
+					uint8 CandidateMask = 0;
+					for (int32 i = 0; i < 8; ++i)
+					{
+						CandidateMask |= static_cast<uint8>((Radial[Index + Offsets[i]] & RadialWithinMaxRadius) != 0) << i;
+					}
+					CandidateMask &= OpenMask;
+					
+					const int32 CandidateCount = FWorldMorphingGrid::CountNeighbors(CandidateMask);
+					if (CandidateCount > 0)
+					{
+						const int32 Slot = FWorldMorphingGrid::GetNthNeighbor(CandidateMask, MakeCellRandom(StageMantleEdge, Index).RandRange(0, CandidateCount - 1));
+						Events.Add({ Index, Index + Offsets[Slot] });
+					}
+				}
+				// 缩减逻辑
+				else if (MantleEnergy[Index] < Params.ShrinkThreshold)
+				{
+					if (Radial[Index] & RadialBeyondMinRadius)
+					{
+						Events.Add({ Index, INDEX_NONE });
+					}
+				}
+			}
+		});
+	}
+	
+	float* MantleEnergy = Grid.MantleEnergy.GetData();
+	for (const TArray<FEdgeEvent>& Events : BandEvents)
+	{
+		for (const FEdgeEvent& Event : Events)
+		{
+			if (!Grid.Exists(Event.Index)) continue;
+			
+			if (Event.Target != INDEX_NONE)
+			{
+				// 目标已被更早的事件占据
+				if (Grid.Exists(Event.Target)) continue;
+				
+				Grid.SetFlag(Event.Target, EWorldCellFlags::Exists, true);
+				EdgeDistance.Repair(Grid, Event.Target);
+				MantleEnergy[Event.Target] = MantleEnergy[Event.Index] * 0.5f;
+				MantleEnergy[Event.Index] *= 0.5f;
+			}
+			else
+			{
+				// 能量回流给邻居
+				const uint8 ExistsMask = Grid.GetNeighborMask(Event.Index, EWorldCellFlags::Exists);
+				const int32 ExistingCount = FWorldMorphingGrid::CountNeighbors(ExistsMask);
+				if (ExistingCount > 0)
+				{
+					float EnergyPerNeighbor = MantleEnergy[Event.Index] / ExistingCount;
+					for (int32 i = 0; i < 8; ++i)
+					{
+						if (ExistsMask & (1 << i))
+						{
+							MantleEnergy[Event.Index + Offsets[i]] += EnergyPerNeighbor;
+						}
+					}
+				}
+				
+				Grid.SetFlag(Event.Index, EWorldCellFlags::Exists, false);
+				EdgeDistance.Repair(Grid, Event.Index);
+				MantleEnergy[Event.Index] = 0.0f;
+				Statistics.OnCrystalChanged(Grid.CrystalState[Event.Index], ECrystalType::Empty);
+				Grid.CrystalState[Event.Index] = ECrystalType::Empty;
+			}
+		}
+	}
+}
+
+// ========== 气候层更新 ==========
+void FWorldMorphingSim::UpdateClimateLayer()
+{
+	const int32* Offsets = Grid.NeighborOffsets;
+	
+	// 季节性偏移
+	float TimeCycle = (TimeStep % 1000) / 1000.0f;
+	float SeasonalOffset = Params.SeasonalAmplitude * FMath::Sin(2.0f * PI * TimeCycle);
+	
+	RefreshExistsMask();
+	
+	// 第一遍: 计算基础温度和扩散（读取上一步温度，写入 BackGrid）
+	{
+		WorldMorphingKernels::FTemperatureParams TemperatureParams;
+		TemperatureParams.DiffusionRate = Params.DiffusionRate;
+		TemperatureParams.SeasonalOffset = SeasonalOffset;
+		
+		const float* MantleEnergy = Grid.MantleEnergy.GetData();
+		const ECrystalType* CrystalState = Grid.CrystalState.GetData();
+		const float* Temperature = Grid.Temperature.GetData();
+		float* NextTemperature = BackGrid.Temperature.GetData();
+		float* TemperatureChange = Grid.TemperatureChange.GetData();
+		
+		ParallelForBands([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			for (int32 RowStart = BeginIndex; RowStart < EndIndex; RowStart += Grid.Pitch)
+			{
+				WorldMorphingKernels::DiffuseTemperature(Offsets, ExistsMask.GetData(), MantleEnergy, CrystalState,
+					Temperature, TemperatureChange, NextTemperature, TemperatureParams, RowStart, Width);
+			}
+		});
+		
+		Swap(Grid.Temperature, BackGrid.Temperature);
+	}
+	
+	// 第二遍: 计算雷暴（读取新温度，写入 BackGrid 的标志位），顺带按行汇总场统计
+	{
+		const float* MantleEnergy = Grid.MantleEnergy.GetData();
+		const float* Temperature = Grid.Temperature.GetData();
+		const EWorldCellFlags* CellFlags = Grid.Flags.GetData();
+		EWorldCellFlags* NextFlags = BackGrid.Flags.GetData();
+		
+		TArray<FWorldMorphingFieldTotals> BandTotals;
+		BandTotals.SetNum(GetNumBands());
+		
+		ParallelForBands([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			for (int32 RowStart = BeginIndex; RowStart < EndIndex; RowStart += Grid.Pitch)
+			{
+				WorldMorphingKernels::UpdateThunderstorms(Offsets, ExistsMask.GetData(), Temperature,
+					CellFlags, NextFlags, Params.ThunderstormThreshold, RowStart, Width);
+				BandTotals[Band].Accumulate(NextFlags, MantleEnergy, Temperature, RowStart, Width);
+			}
+		});
+		
+		Swap(Grid.Flags, BackGrid.Flags);
+		
+		FWorldMorphingFieldTotals Totals;
+		for (const FWorldMorphingFieldTotals& BandTotal : BandTotals)
+		{
+			Totals += BandTotal;
+		}
+		Statistics.SetFieldTotals(Totals);
+	}
+}
+
+// ========== 晶石层更新 ==========
+void FWorldMorphingSim::UpdateCrystalLayer()
+{
+	const int32* Offsets = Grid.NeighborOffsets;
+	
+	auto IsAlpha = [this](int32 Index)
+	{
+		return Grid.Exists(Index) && Grid.CrystalState[Index] == ECrystalType::Alpha;
+	};
+	
+	// 只处理 Alpha 晶石所在的块及其一圈邻块（扩张目标和孤立判定都只看8邻域）
+	CrystalActivity.Refresh(Grid, IsAlpha, 1);
+	
+	// 遍历处理集合中的单元格（按条带并行，条带内按下标顺序）
+	auto ForEachActiveSpan = [this](TFunctionRef<void(int32 Band, int32 BeginIndex, int32 EndIndex)> Body)
+	{
+		ParallelForBands([this, &Body](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			CrystalActivity.ForEachSpan(Grid, Band, [Band, &Body](int32 SpanBegin, int32 SpanEnd)
+			{
+				Body(Band, SpanBegin, SpanEnd);
+			});
+		});
+	};
+	
+	// 把 BackGrid 中处理过的区间写回 Grid（未处理的块两边都不动）
+	auto CommitActiveSpans = [&ForEachActiveSpan](auto& Plane, const auto& BackPlane)
+	{
+		ForEachActiveSpan([&Plane, &BackPlane](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			FMemory::Memcpy(Plane.GetData() + BeginIndex, BackPlane.GetData() + BeginIndex, (EndIndex - BeginIndex) * sizeof(Plane[0]));
+		});
+	};
+	
+	// 1. 能量获取与消耗（只读写自身，原地并行）
+	{
+		float* StoredEnergy = Grid.StoredEnergy.GetData();
+		float* MantleEnergy = Grid.MantleEnergy.GetData();
+		float* CrystalEnergy = Grid.CrystalEnergy.GetData();
+		
+		// 各条带吸收的地幔能量（补记到统计）
+		TArray<double> BandAbsorbed;
+		BandAbsorbed.Init(0.0, GetNumBands());
+		
+		ForEachActiveSpan([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			for (int32 Index = BeginIndex; Index < EndIndex; ++Index)
+			{
+				if (!IsAlpha(Index))
+				{
+					Grid.SetFlag(Index, EWorldCellFlags::Absorbing, false);
+					CrystalEnergy[Index] = 0.0f;
+					continue;
+				}
+				
+				// 吸收地幔能量
+				float EnergyInput = 0.0f;
+				float Absorbed = MantleEnergy[Index] * Params.MantleAbsorption;
+				EnergyInput += Absorbed;
+				
+				if (Absorbed > 0.1f)
+				{
+					const float Remaining = FMath::Max(0.0f, MantleEnergy[Index] - Absorbed);
+					BandAbsorbed[Band] += MantleEnergy[Index] - Remaining;
+					MantleEnergy[Index] = Remaining;
+					Grid.SetFlag(Index, EWorldCellFlags::Absorbing, true);
+				}
+				else
+				{
+					Grid.SetFlag(Index, EWorldCellFlags::Absorbing, false);
+				}
+				
+				// 雷暴能量
+				if (Grid.HasFlag(Index, EWorldCellFlags::Thunderstorm))
+				{
+					EnergyInput += Params.ThunderstormEnergy;
+				}
+				
+				// 记录输入用于可视化
+				CrystalEnergy[Index] = EnergyInput;
+				
+				// 能量结算
+				float NetEnergy = EnergyInput - Params.AlphaEnergyDemand;
+				
+				// 能量上限
+				StoredEnergy[Index] = FMath::Min(StoredEnergy[Index] + NetEnergy, Params.MaxCrystalEnergy);
+			}
+		});
+		
+		for (double Absorbed : BandAbsorbed)
+		{
+			Statistics.AddMantleEnergy(-Absorbed);
+		}
+	}
+	
+	// 1.5 能量共享（汇聚形式: 每个晶石结算从邻居流入和流向邻居的能量，写入 BackGrid 后写回）
+	{
+		const float* StoredEnergy = Grid.StoredEnergy.GetData();
+		float* NextStoredEnergy = BackGrid.StoredEnergy.GetData();
+		const float Limit = Params.MaxCrystalEnergy * Params.EnergySharingLimit;
+		
+		ForEachActiveSpan([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			for (int32 Index = BeginIndex; Index < EndIndex; ++Index)
+			{
+				if (!IsAlpha(Index))
+				{
+					NextStoredEnergy[Index] = StoredEnergy[Index];
+					continue;
+				}
+				
+				float Change = 0.0f;
+				for (int32 i = 0; i < 8; ++i)
+				{
+					const int32 NIndex = Index + Offsets[i];
+					if (!IsAlpha(NIndex)) continue;
+					
+					float Diff = StoredEnergy[NIndex] - StoredEnergy[Index];
+					if (Diff > 0.0f)
+					{
+						// 从邻居流入（接收方不能超过共享上限）
+						float Flow = Diff * Params.EnergySharingRate;
+						if (StoredEnergy[Index] + Flow <= Limit)
+						{
+							Change += Flow;
+						}
+					}
+					else if (Diff < 0.0f)
+					{
+						// 流向邻居
+						float Flow = -Diff * Params.EnergySharingRate;
+						if (StoredEnergy[NIndex] + Flow <= Limit)
+						{
+							Change -= Flow;
+						}
+					}
+				}
+				
+				NextStoredEnergy[Index] = FMath::Clamp(StoredEnergy[Index] + Change, 0.0f, Params.MaxCrystalEnergy);
+			}
+		});
+		
+		CommitActiveSpans(Grid.StoredEnergy, BackGrid.StoredEnergy);
+	}
+	
+	// 2. 状态转移（每个单元格写入自身的下一状态；扩张对父晶石的能量扣除进入条带队列）
+	{
+		const ECrystalType* CrystalState = Grid.CrystalState.GetData();
+		const float* StoredEnergy = Grid.StoredEnergy.GetData();
+		ECrystalType* NextStates = BackGrid.CrystalState.GetData();
+		float* NextStoredEnergy = BackGrid.StoredEnergy.GetData();
+		
+		TArray<TArray<int32>> BandParents;
+		BandParents.SetNum(GetNumBands());
+		
+		TArray<FWorldMorphingCrystalDeltas> BandDeltas;
+		BandDeltas.SetNum(GetNumBands());
+		
+		ForEachActiveSpan([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+		{
+			for (int32 Index = BeginIndex; Index < EndIndex; ++Index)
+			{
+				NextStates[Index] = CrystalState[Index];
+				NextStoredEnergy[Index] = StoredEnergy[Index];
+				
+				if (!Grid.Exists(Index)) continue;
+				
+				const uint8 ExistsMask = Grid.GetNeighborMask(Index, EWorldCellFlags::Exists);
+				const uint8 AlphaMask = ExistsMask & Grid.GetCrystalNeighborMask(Index, ECrystalType::Alpha);
+				
+				if (CrystalState[Index] == ECrystalType::Empty)
+				{
+					// 规则1: 扩张
+					uint8 RichMask = 0;
+					for (int32 i = 0; i < 8; ++i)
+					{
+						if ((AlphaMask & (1 << i)) && StoredEnergy[Index + Offsets[i]] >= Params.ExpansionCost)
+						{
+							RichMask |= 1 << i;
+						}
+					}
+					
+					const int32 RichCount = FWorldMorphingGrid::CountNeighbors(RichMask);
+					FWorldMorphingCellRandom Random = MakeCellRandom(StageCrystalTransition, Index);
+					if (RichCount > 0 && Random.FRand() < 0.3f)
+					{
+						const int32 Slot = FWorldMorphingGrid::GetNthNeighbor(RichMask, Random.RandRange(0, RichCount - 1));
+						NextStates[Index] = ECrystalType::Alpha;
+						NextStoredEnergy[Index] = 5.0f;
+						BandParents[Band].Add(Index + Offsets[Slot]);
+					}
+				}
+				else if (CrystalState[Index] == ECrystalType::Alpha)
+				{
+					// 规则2: 硬化
+					if (StoredEnergy[Index] <= 0.0f)
+					{
+						NextStates[Index] = ECrystalType::Beta;
+						NextStoredEnergy[Index] = 0.0f;
+					}
+					
+					// 规则3: 孤立死亡
+					const int32 BetaCount = FWorldMorphingGrid::CountNeighbors(ExistsMask & Grid.GetCrystalNeighborMask(Index, ECrystalType::Beta));
+					if (AlphaMask == 0 && BetaCount < 2 && StoredEnergy[Index] < 5.0f)
+					{
+						NextStates[Index] = ECrystalType::Empty;
+						NextStoredEnergy[Index] = 0.0f;
+					}
+				}
+				// Beta晶石不可逆,保持不变
+				
+				if (NextStates[Index] != CrystalState[Index])
+				{
+					BandDeltas[Band].Add(CrystalState[Index], NextStates[Index]);
+				}
+			}
+		});
+		
+		// 按条带顺序扣除扩张消耗
+		for (const TArray<int32>& Parents : BandParents)
+		{
+			for (int32 Parent : Parents)
+			{
+				NextStoredEnergy[Parent] = FMath::Max(0.0f, NextStoredEnergy[Parent] - Params.ExpansionCost);
+			}
+		}
+		
+		for (const FWorldMorphingCrystalDeltas& Deltas : BandDeltas)
+		{
+			Statistics.ApplyCrystalDeltas(Deltas);
+		}
+		
+		CommitActiveSpans(Grid.CrystalState, BackGrid.CrystalState);
+		CommitActiveSpans(Grid.StoredEnergy, BackGrid.StoredEnergy);
+	}
+}
+
+// ========== 人类层更新 ==========
+void FWorldMorphingSim::UpdateHumanLayer()
+{
+	const int32* Offsets = Grid.NeighborOffsets;
+	ECrystalType* CrystalState = Grid.CrystalState.GetData();
+	const float* Temperature = Grid.Temperature.GetData();
+	float* Prosperity = Grid.Prosperity.GetData();
+	uint32* Proposals = HumanProposals.GetData();
+	float* ProposedProsperity = HumanProposedProsperity.GetData();
+	uint8* Arrivals = HumanArrivals.GetData();
+	
+	// 只处理有人类聚落的块，向外扩展一块：聚落的目标单元格（8邻域）也要在汇聚阶段被访问
+	HumanActivity.Refresh(Grid, [CrystalState](int32 Index) { return CrystalState[Index] == ECrystalType::Human; }, 1);
+	
+	// 1. 检查是否需要初始化人类
+	if (Statistics.GetCrystalCount(ECrystalType::Human) == 0)
+	{
+		// 随机生成一个人类聚落
+		int32 Attempts = 0;
+		while (Attempts < 100)
+		{
+			int32 RX = RandomStream.RandRange(0, Width - 1);
+			int32 RY = RandomStream.RandRange(0, Height - 1);
+			const int32 Index = Grid.ToIndex(RX, RY);
+			
+			bool IsTempSuitable = Temperature[Index] >= Params.HumanMinTemp && Temperature[Index] <= Params.HumanMaxTemp;
+			
+			if (Grid.Exists(Index) && CrystalState[Index] != ECrystalType::Alpha && (IsTempSuitable || Attempts > 50))
+			{
+				Statistics.OnCrystalChanged(CrystalState[Index], ECrystalType::Human);
+				CrystalState[Index] = ECrystalType::Human;
+				Grid.Prosperity[Index] = 50.0f;
+				HumanActivity.MarkCell(Grid, Index);
+				break;
+			}
+			Attempts++;
+		}
+		return; // 这一帧只做初始化
+	}
+	
+	// 人类层分三个并行阶段，每个阶段每个单元格只写自己，不需要变更队列：
+	// A. 提议：每个聚落只读取当前状态，把决定（采矿、扩张、迁移的目标槽位和新繁荣度）写入自己的提议单元格
+	// B. 汇聚：每个非聚落单元格查看8邻域中指向自己的提议，按确定的优先级选出一个到达者（扩张或迁移），
+	//    没有到达者时执行采矿；胜出的邻居槽位写入到达平面
+	// C. 结算：每个聚落查看自己的目标是否选中了自己，更新繁荣度或迁出，并清空自己的提议
+	// 提议平面在处理集合之外始终为0（A 只写处理集合中的聚落，C 清空同一批单元格）
+	
+	// A. 提议
+	ParallelForBands([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+	{
+		HumanActivity.ForEachSpan(Grid, Band, [&](int32 SpanBegin, int32 SpanEnd)
+		{
+			for (int32 Index = SpanBegin; Index < SpanEnd; ++Index)
+			{
+				if (CrystalState[Index] != ECrystalType::Human) continue;
+				
+				// A. 温度检查
+				if (Temperature[Index] < Params.HumanSurvivalMinTemp || Temperature[Index] > Params.HumanSurvivalMaxTemp)
+				{
+					// 极端温度,直接抹杀
+					Proposals[Index] = HumanProposalSource | HumanProposalDies;
+					continue;
+				}
+				
+				uint32 Proposal = HumanProposalSource;
+				FWorldMorphingCellRandom Random = MakeCellRandom(StageHumanUpdate, Index);
+				
+				// B. 繁荣度更新
+				float ProsperityChange = 0.0f;
+				if (Temperature[Index] >= Params.HumanMinTemp && Temperature[Index] <= Params.HumanMaxTemp)
+				{
+					ProsperityChange += Params.HumanProsperityGrowth;
+				}
+				else
+				{
+					ProsperityChange -= Params.HumanProsperityDecay;
+				}
+				
+				// 邻居加成
+				const int32 HumanNeighborCount = FWorldMorphingGrid::CountNeighbors(Grid.GetCrystalNeighborMask(Index, ECrystalType::Human));
+				ProsperityChange += HumanNeighborCount * 0.1f;
+				
+				// C. 采矿(消除相邻Beta晶石)
+				const uint8 BetaMask = Grid.GetCrystalNeighborMask(Index, ECrystalType::Beta);
+				const int32 BetaCount = FWorldMorphingGrid::CountNeighbors(BetaMask);
+				
+				if (BetaCount > 0)
+				{
+					Proposal |= EncodeHumanSlot(FWorldMorphingGrid::GetNthNeighbor(BetaMask, Random.RandRange(0, BetaCount - 1)), HumanMineShift);
+					ProsperityChange += Params.HumanMiningReward;
+				}
+				
+				const float NextProsperity = Prosperity[Index] + ProsperityChange;
+				
+				// D. 扩张
+				if (NextProsperity > Params.HumanExpansionThreshold)
+				{
+					uint8 TargetMask = 0;
+					for (int32 i = 0; i < 8; ++i)
+					{
+						const int32 NIndex = Index + Offsets[i];
+						if (Grid.Exists(NIndex) && CrystalState[NIndex] != ECrystalType::Alpha && CrystalState[NIndex] != ECrystalType::Human)
+						{
+							TargetMask |= 1 << i;
+						}
+					}
+					
+					const int32 TargetCount = FWorldMorphingGrid::CountNeighbors(TargetMask);
+					if (TargetCount > 0)
+					{
+						Proposal |= EncodeHumanSlot(FWorldMorphingGrid::GetNthNeighbor(TargetMask, Random.RandRange(0, TargetCount - 1)), HumanExpandShift);
+					}
+				}
+				
+				// E. 迁移
+				if (NextProsperity < Params.HumanMigrationThreshold)
+				{
+					// 寻找更好的位置
+					int32 BestSlot = INDEX_NONE;
+					float BestScore = -1000.0f;
+					
+					for (int32 i = 0; i < 8; ++i)
+					{
+						const int32 NIndex = Index + Offsets[i];
+						if (!Grid.Exists(NIndex) || CrystalState[NIndex] != ECrystalType::Empty) continue;
+						
+						float Score = 0.0f;
+						if (Temperature[NIndex] >= Params.HumanMinTemp && Temperature[NIndex] <= Params.HumanMaxTemp)
+						{
+							Score += 10.0f;
+						}
+						
+						// 计算Beta邻居数量
+						Score += FWorldMorphingGrid::CountNeighbors(Grid.GetCrystalNeighborMask(NIndex, ECrystalType::Beta));
+						
+						if (Score > BestScore)
+						{
+							BestScore = Score;
+							BestSlot = i;
+						}
+					}
+					
+					if (BestSlot != INDEX_NONE && BestScore > 0.0f)
+					{
+						Proposal |= EncodeHumanSlot(BestSlot, HumanMigrateShift);
+					}
+				}
+				
+				Proposals[Index] = Proposal;
+				ProposedProsperity[Index] = NextProsperity;
+			}
+		});
+	});
+	
+	// B. 汇聚（晶石计数变化按条带收集，最后按条带顺序合并）
+	TArray<FWorldMorphingCrystalDeltas> BandDeltas;
+	BandDeltas.SetNum(GetNumBands());
+	
+	ParallelForBands([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+	{
+		FWorldMorphingCrystalDeltas& Deltas = BandDeltas[Band];
+		
+		HumanActivity.ForEachSpan(Grid, Band, [&](int32 SpanBegin, int32 SpanEnd)
+		{
+			for (int32 Index = SpanBegin; Index < SpanEnd; ++Index)
+			{
+				Arrivals[Index] = 0;
+				if (Proposals[Index] & HumanProposalSource) continue;
+				
+				// 到达者优先级: 来源的新繁荣度高者优先，相同时槽位小者优先
+				int32 WinnerSlot = INDEX_NONE;
+				bool bWinnerMigrates = false;
+				float WinnerPriority = 0.0f;
+				bool bMined = false;
+				
+				for (int32 i = 0; i < 8; ++i)
+				{
+					const int32 Source = Index + Offsets[i];
+					const uint32 Proposal = Proposals[Source];
+					if (!(Proposal & HumanProposalSource)) continue;
+					
+					const int32 TowardsMe = OppositeSlot(i);
+					bMined |= DecodeHumanSlot(Proposal, HumanMineShift) == TowardsMe;
+					
+					const bool bExpands = DecodeHumanSlot(Proposal, HumanExpandShift) == TowardsMe;
+					const bool bMigrates = DecodeHumanSlot(Proposal, HumanMigrateShift) == TowardsMe;
+					if ((bExpands || bMigrates) && (WinnerSlot == INDEX_NONE || ProposedProsperity[Source] > WinnerPriority))
+					{
+						// 扩张和迁移指向同一单元格时按扩张处理（扩张先占据该单元格，迁移落空）
+						WinnerSlot = i;
+						bWinnerMigrates = bMigrates && !bExpands;
+						WinnerPriority = ProposedProsperity[Source];
+					}
+				}
+				
+				if (WinnerSlot != INDEX_NONE)
+				{
+					// 扩张得到新聚落，迁移带来来源原繁荣度的八成
+					Deltas.Add(CrystalState[Index], ECrystalType::Human);
+					CrystalState[Index] = ECrystalType::Human;
+					Prosperity[Index] = bWinnerMigrates ? Prosperity[Index + Offsets[WinnerSlot]] * 0.8f : 50.0f;
+					Arrivals[Index] = static_cast<uint8>(WinnerSlot + 1);
+					HumanActivity.MarkCell(Grid, Index);
+				}
+				else if (bMined)
+				{
+					Deltas.Add(CrystalState[Index], ECrystalType::Empty);
+					CrystalState[Index] = ECrystalType::Empty;
+					Prosperity[Index] = 0.0f;
+				}
+			}
+		});
+	});
+	
+	// C. 结算
+	ParallelForBands([&](int32 Band, int32 BeginIndex, int32 EndIndex)
+	{
+		FWorldMorphingCrystalDeltas& Deltas = BandDeltas[Band];
+		
+		HumanActivity.ForEachSpan(Grid, Band, [&](int32 SpanBegin, int32 SpanEnd)
+		{
+			for (int32 Index = SpanBegin; Index < SpanEnd; ++Index)
+			{
+				const uint32 Proposal = Proposals[Index];
+				if (!(Proposal & HumanProposalSource)) continue;
+				
+				Proposals[Index] = 0;
+				
+				// 目标单元格选中的到达者是否为自己
+				auto WonAt = [&](int32 Shift)
+				{
+					const int32 Slot = DecodeHumanSlot(Proposal, Shift);
+					return Slot != INDEX_NONE && Arrivals[Index + Offsets[Slot]] == OppositeSlot(Slot) + 1;
+				};
+				
+				if ((Proposal & HumanProposalDies) || WonAt(HumanMigrateShift))
+				{
+					Deltas.Add(ECrystalType::Human, ECrystalType::Empty);
+					CrystalState[Index] = ECrystalType::Empty;
+					Prosperity[Index] = 0.0f;
+					continue;
+				}
+				
+				Prosperity[Index] = FMath::Clamp(ProposedProsperity[Index], 0.0f, 100.0f);
+			}
+		});
+	});
+	
+	for (const FWorldMorphingCrystalDeltas& Deltas : BandDeltas)
+	{
+		Statistics.ApplyCrystalDeltas(Deltas);
+	}
+}
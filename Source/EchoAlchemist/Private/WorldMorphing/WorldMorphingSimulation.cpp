@@ -98,6 +98,17 @@ void UWorldMorphingSimulation::SetPaused(UObject* WorldContextObject, bool bPaus
 	UE_LOG(LogTemp, Warning, TEXT("WorldMorphingSimulation::SetPaused - Not implemented yet"));
 }
 
+void UWorldMorphingSimulation::SetTimeWarp(UObject* WorldContextObject, float StepsPerSecond, float FrameBudgetMs)
+{
+	UWorldMorphingSubsystem* Subsystem = GetWorldMorphingSubsystem(WorldContextObject);
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	Subsystem->SetTimeWarp(StepsPerSecond, FrameBudgetMs);
+}
+
 FSimulationStatus UWorldMorphingSimulation::GetStatus(UObject* WorldContextObject)
 {
 	FSimulationStatus Status;
@@ -114,6 +125,7 @@ FSimulationStatus UWorldMorphingSimulation::GetStatus(UObject* WorldContextObjec
 	Status.CycleCount = Subsystem->GetCycleCount();
 	Status.bInitialized = (Status.Width > 0 && Status.Height > 0);
 	Status.bPaused = false; // 暂时固定为false
+	Status.StepsPerSecond = Subsystem->GetAchievedStepsPerSecond();
 
 	return Status;
 }
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingSnapshot.h"
+
+void FWorldMorphingSnapshotBuffer::Reset()
+{
+	for (FWorldMorphingSnapshot& Snapshot : Buffers)
+	{
+		Snapshot = FWorldMorphingSnapshot();
+	}
+
+	WriteIndex = 0;
+	ReadIndex = 1;
+	NextVersion = 1;
+	MiddleSlot.store(2, std::memory_order_relaxed);
+}
+
+void FWorldMorphingSnapshotBuffer::Publish()
+{
+	Buffers[WriteIndex].Version = NextVersion++;
+
+	// 把写好的缓冲放入中间槽位，取回读取端不再持有的那个继续写
+	const uint32 Previous = MiddleSlot.exchange(WriteIndex | FreshBit, std::memory_order_acq_rel);
+	WriteIndex = Previous & IndexMask;
+}
+
+const FWorldMorphingSnapshot& FWorldMorphingSnapshotBuffer::AcquireLatest()
+{
+	if (MiddleSlot.load(std::memory_order_relaxed) & FreshBit)
+	{
+		const uint32 Previous = MiddleSlot.exchange(ReadIndex, std::memory_order_acq_rel);
+		ReadIndex = Previous & IndexMask;
+	}
+
+	return Buffers[ReadIndex];
+}
@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingStatistics.h"
+
+void FWorldMorphingFieldTotals::Accumulate(const EWorldCellFlags* Flags, const float* InMantleEnergy, const float* InTemperature, int32 Begin, int32 Count)
+{
+	for (int32 Index = Begin; Index < Begin + Count; ++Index)
+	{
+		if (EnumHasAnyFlags(Flags[Index], EWorldCellFlags::Exists))
+		{
+			TerrainCells++;
+			MantleEnergy += InMantleEnergy[Index];
+			Temperature += InTemperature[Index];
+		}
+
+		if (EnumHasAnyFlags(Flags[Index], EWorldCellFlags::Thunderstorm))
+		{
+			ThunderstormCells++;
+		}
+	}
+}
+
+void FWorldMorphingStatistics::Recompute(const FWorldMorphingGrid& Grid)
+{
+	Reset();
+	TotalCells = Grid.Width * Grid.Height;
+
+	for (int32 Y = 0; Y < Grid.Height; ++Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		FieldTotals.Accumulate(Grid.Flags.GetData(), Grid.MantleEnergy.GetData(), Grid.Temperature.GetData(), RowStart, Grid.Width);
+
+		for (int32 Index = RowStart; Index < RowStart + Grid.Width; ++Index)
+		{
+			CrystalDeltas.Counts[static_cast<int32>(Grid.CrystalState[Index])]++;
+		}
+	}
+}
+
+void FWorldMorphingStatistics::Reset()
+{
+	TotalCells = 0;
+	CrystalDeltas = FWorldMorphingCrystalDeltas();
+	FieldTotals = FWorldMorphingFieldTotals();
+}
+
+void FWorldMorphingStatistics::ApplyCrystalDeltas(const FWorldMorphingCrystalDeltas& Deltas)
+{
+	for (int32 Type = 0; Type < FWorldMorphingCrystalDeltas::NumTypes; ++Type)
+	{
+		CrystalDeltas.Counts[Type] += Deltas.Counts[Type];
+	}
+}
+
+FWorldStatistics FWorldMorphingStatistics::ToStatistics() const
+{
+	FWorldStatistics Stats;
+	Stats.TotalCells = TotalCells;
+	Stats.TerrainCells = FieldTotals.TerrainCells;
+	Stats.AlphaCrystals = GetCrystalCount(ECrystalType::Alpha);
+	Stats.BetaCrystals = GetCrystalCount(ECrystalType::Beta);
+	Stats.HumanSettlements = GetCrystalCount(ECrystalType::Human);
+	Stats.ThunderstormCells = FieldTotals.ThunderstormCells;
+
+	if (FieldTotals.TerrainCells > 0)
+	{
+		Stats.AverageMantleEnergy = static_cast<float>(FieldTotals.MantleEnergy / FieldTotals.TerrainCells);
+		Stats.AverageTemperature = static_cast<float>(FieldTotals.Temperature / FieldTotals.TerrainCells);
+	}
+
+	return Stats;
+}
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingSupplyDensity.h"
+
+void FWorldMorphingSupplyDensity::Build(TConstArrayView<FEdgeSupplyPoint> Points, float Sigma)
+{
+	// 宽度改变时重建高斯核
+	if (Sigma != KernelSigma)
+	{
+		KernelSigma = Sigma;
+		const float SafeSigma = FMath::Max(Sigma, KINDA_SMALL_NUMBER);
+		const float BinWidth = 1.0f / BinsPerRadian;
+
+		Kernel.SetNumUninitialized(NumBins / 2 + 2);
+		for (int32 k = 0; k < Kernel.Num(); ++k)
+		{
+			const float Diff = k * BinWidth;
+			Kernel[k] = FMath::Exp(-(Diff * Diff) / (2.0f * SafeSigma * SafeSigma));
+		}
+	}
+
+	Density.Init(0.0f, NumBins);
+	float* Bins = Density.GetData();
+	const float* KernelData = Kernel.GetData();
+
+	for (const FEdgeSupplyPoint& Point : Points)
+	{
+		const float PointPosition = Point.Angle * BinsPerRadian;
+		for (int32 Bin = 0; Bin < NumBins; ++Bin)
+		{
+			// 圆周上的分箱距离
+			float Distance = FMath::Abs(Bin - PointPosition);
+			if (Distance > NumBins / 2)
+			{
+				Distance = FMath::Max(0.0f, NumBins - Distance);
+			}
+
+			const int32 K = FMath::Min(FMath::FloorToInt32(Distance), NumBins / 2);
+			Bins[Bin] += FMath::Lerp(KernelData[K], KernelData[K + 1], Distance - K);
+		}
+	}
+}
+
+float FWorldMorphingSupplyDensity::Evaluate(TConstArrayView<FEdgeSupplyPoint> Points, float Sigma, float Angle)
+{
+	float Result = 0.0f;
+	for (const FEdgeSupplyPoint& Point : Points)
+	{
+		float Diff = FMath::Abs(Angle - Point.Angle);
+		if (Diff > PI) Diff = PI * 2.0f - Diff;
+
+		Result += FMath::Exp(-(Diff * Diff) / (2.0f * Sigma * Sigma));
+	}
+	return Result;
+}
@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldMorphing/WorldMorphingSweepCommandlet.h"
+#include "WorldMorphing/WorldMorphingSim.h"
+#include "WorldMorphing/WorldMorphingConfiguration.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/** 一个实验世界的配置和采样结果 */
+	struct FSweepWorld
+	{
+		FSimulationParams Params;
+		TArray<int32> SampleSteps;
+		TArray<FWorldStatistics> Samples;
+	};
+
+	/**
+	 * 读取参数表（首行为属性名，之后每行一个世界）
+	 * @return 文件无法读取或列名无效时返回 false
+	 */
+	bool LoadParamsFile(const FString& FilePath, const FSimulationParams& BaseParams, TArray<FSweepWorld>& OutWorlds)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath) || Lines.Num() == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("WorldMorphingSweep: failed to read %s"), *FilePath);
+			return false;
+		}
+
+		TArray<FString> Columns;
+		Lines[0].ParseIntoArray(Columns, TEXT(","), false);
+
+		TArray<FProperty*> Properties;
+		for (FString& Column : Columns)
+		{
+			Column.TrimStartAndEndInline();
+			FProperty* Property = FSimulationParams::StaticStruct()->FindPropertyByName(FName(*Column));
+			if (!Property)
+			{
+				UE_LOG(LogTemp, Error, TEXT("WorldMorphingSweep: unknown parameter '%s' in %s"), *Column, *FilePath);
+				return false;
+			}
+			Properties.Add(Property);
+		}
+
+		for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+		{
+			if (Lines[LineIndex].TrimStartAndEnd().IsEmpty()) continue;
+
+			TArray<FString> Cells;
+			Lines[LineIndex].ParseIntoArray(Cells, TEXT(","), false);
+
+			FSweepWorld& World = OutWorlds.AddDefaulted_GetRef();
+			World.Params = BaseParams;
+			World.Params.RandomSeed = 0;
+			for (int32 Column = 0; Column < FMath::Min(Cells.Num(), Properties.Num()); ++Column)
+			{
+				const FString Value = Cells[Column].TrimStartAndEnd();
+				if (!Value.IsEmpty())
+				{
+					Properties[Column]->ImportText_Direct(*Value, Properties[Column]->ContainerPtrToValuePtr<void>(&World.Params), nullptr, PPF_None);
+				}
+			}
+		}
+
+		return true;
+	}
+}
+
+UWorldMorphingSweepCommandlet::UWorldMorphingSweepCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UWorldMorphingSweepCommandlet::Main(const FString& Params)
+{
+	int32 NumWorlds = 16;
+	int32 Steps = 1000;
+	int32 Size = 128;
+	int32 BaseSeed = 1;
+	int32 Interval = 10;
+	FParse::Value(*Params, TEXT("Worlds="), NumWorlds);
+	FParse::Value(*Params, TEXT("Steps="), Steps);
+	FParse::Value(*Params, TEXT("Size="), Size);
+	FParse::Value(*Params, TEXT("Seed="), BaseSeed);
+	FParse::Value(*Params, TEXT("Interval="), Interval);
+
+	int32 Width = Size;
+	int32 Height = Size;
+	FParse::Value(*Params, TEXT("Width="), Width);
+	FParse::Value(*Params, TEXT("Height="), Height);
+
+	FString PresetName;
+	ESimulationPreset Preset = ESimulationPreset::Default;
+	if (FParse::Value(*Params, TEXT("Preset="), PresetName))
+	{
+		const int64 PresetValue = StaticEnum<ESimulationPreset>()->GetValueByNameString(PresetName);
+		if (PresetValue == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Error, TEXT("WorldMorphingSweep: unknown preset '%s'"), *PresetName);
+			return 1;
+		}
+		Preset = static_cast<ESimulationPreset>(PresetValue);
+	}
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("WorldMorphing/Sweep.csv");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	if (Width <= 0 || Height <= 0 || Steps < 0 || Interval <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("WorldMorphingSweep: invalid arguments (%dx%d, %d steps, interval %d)"), Width, Height, Steps, Interval);
+		return 1;
+	}
+
+	// 构建世界列表
+	const FSimulationParams BaseParams = UWorldMorphingConfiguration::MakePreset(Preset);
+	TArray<FSweepWorld> Worlds;
+	FString ParamsFile;
+	if (FParse::Value(*Params, TEXT("ParamsFile="), ParamsFile))
+	{
+		if (!LoadParamsFile(ParamsFile, BaseParams, Worlds))
+		{
+			return 1;
+		}
+	}
+	else
+	{
+		Worlds.SetNum(FMath::Max(NumWorlds, 0));
+		for (FSweepWorld& World : Worlds)
+		{
+			World.Params = BaseParams;
+			World.Params.RandomSeed = 0;
+		}
+	}
+
+	for (int32 WorldIndex = 0; WorldIndex < Worlds.Num(); ++WorldIndex)
+	{
+		FSimulationParams& WorldParams = Worlds[WorldIndex].Params;
+		if (WorldParams.RandomSeed == 0)
+		{
+			// 种子为0会让模拟随机选取，这里改用确定的种子，实验可以复现
+			const int32 WorldSeed = BaseSeed + WorldIndex;
+			WorldParams.RandomSeed = WorldSeed != 0 ? WorldSeed : -1;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("WorldMorphingSweep: %d worlds, %dx%d, %d steps (sample every %d)"),
+		Worlds.Num(), Width, Height, Steps, Interval);
+
+	// 每个世界单线程推进，并行发生在世界之间
+	const double StartTime = FPlatformTime::Seconds();
+	std::atomic<int32> NumFinished{ 0 };
+	ParallelFor(Worlds.Num(), [&](int32 WorldIndex)
+	{
+		FSweepWorld& World = Worlds[WorldIndex];
+
+		FWorldMorphingSim Sim;
+		Sim.SetUseMultithreading(false);
+		Sim.Initialize(Width, Height, World.Params);
+
+		const int32 NumSamples = Steps / Interval + (Steps % Interval != 0 ? 2 : 1);
+		World.SampleSteps.Reserve(NumSamples);
+		World.Samples.Reserve(NumSamples);
+
+		for (int32 Step = 0; Step <= Steps; ++Step)
+		{
+			if (Step > 0)
+			{
+				Sim.Step();
+			}
+
+			if (Step % Interval == 0 || Step == Steps)
+			{
+				World.SampleSteps.Add(Step);
+				World.Samples.Add(Sim.GetStatistics());
+			}
+		}
+
+		const int32 Finished = ++NumFinished;
+		UE_LOG(LogTemp, Display, TEXT("WorldMorphingSweep: world %d finished (%d/%d)"), WorldIndex, Finished, Worlds.Num());
+	}, EParallelForFlags::Unbalanced);
+
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	// 写入CSV（按世界和步数排序，与线程调度无关）
+	FString Csv = TEXT("World,Seed,Step,TerrainCells,AlphaCrystals,BetaCrystals,HumanSettlements,ThunderstormCells,AverageMantleEnergy,AverageTemperature\n");
+	for (int32 WorldIndex = 0; WorldIndex < Worlds.Num(); ++WorldIndex)
+	{
+		const FSweepWorld& World = Worlds[WorldIndex];
+		for (int32 Sample = 0; Sample < World.Samples.Num(); ++Sample)
+		{
+			const FWorldStatistics& Stats = World.Samples[Sample];
+			Csv.Appendf(TEXT("%d,%d,%d,%d,%d,%d,%d,%d,%.4f,%.4f\n"),
+				WorldIndex, World.Params.RandomSeed, World.SampleSteps[Sample],
+				Stats.TerrainCells, Stats.AlphaCrystals, Stats.BetaCrystals, Stats.HumanSettlements, Stats.ThunderstormCells,
+				Stats.AverageMantleEnergy, Stats.AverageTemperature);
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("WorldMorphingSweep: failed to write %s"), *OutputPath);
+		return 1;
+	}
+
+	const double WorldSteps = static_cast<double>(Worlds.Num()) * Steps;
+	UE_LOG(LogTemp, Display, TEXT("WorldMorphingSweep: wrote %s in %.2fs (%.0f world-steps/s)"),
+		*OutputPath, Elapsed, Elapsed > 0.0 ? WorldSteps / Elapsed : 0.0);
+
+	return 0;
+}
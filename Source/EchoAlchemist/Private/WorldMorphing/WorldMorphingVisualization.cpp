@@ -4,6 +4,10 @@
 #include "WorldMorphing/WorldMorphingSubsystem.h"
 #include "Engine/GameInstance.h"
 
+// 最近一次解析的子系统（UI每帧调用，避免重复遍历世界上下文）
+static TWeakObjectPtr<UWorld> CachedVisualizationWorld;
+static TWeakObjectPtr<UWorldMorphingSubsystem> CachedVisualizationSubsystem;
+
 static UWorldMorphingSubsystem* GetWorldMorphingSubsystemForVisualization(UObject* WorldContextObject)
 {
 	UWorld* World = nullptr;
@@ -14,6 +18,16 @@ static UWorldMorphingSubsystem* GetWorldMorphingSubsystemForVisualization(UObjec
 		World = WorldContextObject->GetWorld();
 	}
 	
+	// 缓存命中: 同一个世界（或没有上下文时沿用上一次的世界）
+	if (UWorldMorphingSubsystem* Cached = CachedVisualizationSubsystem.Get())
+	{
+		UWorld* CachedWorld = CachedVisualizationWorld.Get();
+		if (CachedWorld && (!World || World == CachedWorld))
+		{
+			return Cached;
+		}
+	}
+	
 	// 方法2: 如果WorldContextObject为nullptr或无法获取World，尝试使用GEngine
 	if (!World && GEngine)
 	{
@@ -42,7 +56,21 @@ static UWorldMorphingSubsystem* GetWorldMorphingSubsystemForVisualization(UObjec
 		return nullptr;
 	}
 
-	return GameInstance->GetSubsystem<UWorldMorphingSubsystem>();
+	UWorldMorphingSubsystem* Subsystem = GameInstance->GetSubsystem<UWorldMorphingSubsystem>();
+	CachedVisualizationWorld = World;
+	CachedVisualizationSubsystem = Subsystem;
+	return Subsystem;
+}
+
+// 从同一份网格读取单元格，保证一次查询内的数据来自同一个快照
+static FCellState ReadCell(const FWorldMorphingGrid& Grid, int32 X, int32 Y)
+{
+	if (X < 0 || X >= Grid.Width || Y < 0 || Y >= Grid.Height)
+	{
+		return FCellState();
+	}
+
+	return Grid.GetCellState(Grid.ToIndex(X, Y));
 }
 
 FCellState UWorldMorphingVisualization::GetCellState(UObject* WorldContextObject, int32 X, int32 Y)
@@ -58,7 +86,8 @@ FCellState UWorldMorphingVisualization::GetCellState(UObject* WorldContextObject
 
 TArray<FCellState> UWorldMorphingVisualization::GetRegionStates(UObject* WorldContextObject, 
                                                                  int32 StartX, int32 StartY, 
-                                                                 int32 Width, int32 Height)
+                                                                 int32 Width, int32 Height,
+                                                                 int32 Lod)
 {
 	TArray<FCellState> States;
 
@@ -68,6 +97,8 @@ TArray<FCellState> UWorldMorphingVisualization::GetRegionStates(UObject* WorldCo
 		return States;
 	}
 
+	const FWorldMorphingGrid& Grid = Subsystem->GetLodGrid(Lod);
+
 	// 预分配数组
 	States.Reserve(Width * Height);
 
@@ -76,98 +107,108 @@ TArray<FCellState> UWorldMorphingVisualization::GetRegionStates(UObject* WorldCo
 	{
 		for (int32 X = StartX; X < StartX + Width; ++X)
 		{
-			States.Add(Subsystem->GetCellAt(X, Y));
+			States.Add(ReadCell(Grid, X, Y));
 		}
 	}
 
 	return States;
 }
 
-FWorldStatistics UWorldMorphingVisualization::GetStatistics(UObject* WorldContextObject)
+void UWorldMorphingVisualization::GetLodSize(UObject* WorldContextObject, int32 Lod, int32& OutWidth, int32& OutHeight)
 {
-	FWorldStatistics Stats;
+	OutWidth = 0;
+	OutHeight = 0;
 
 	UWorldMorphingSubsystem* Subsystem = GetWorldMorphingSubsystemForVisualization(WorldContextObject);
 	if (!Subsystem)
 	{
-		return Stats;
+		return;
 	}
 
-	// 获取网格尺寸
-	int32 GridWidth, GridHeight;
-	Subsystem->GetGridSize(GridWidth, GridHeight);
-	Stats.TotalCells = GridWidth * GridHeight;
-
-	// 遍历所有单元格统计
-	float TotalMantleEnergy = 0.0f;
-	float TotalTemperature = 0.0f;
-	int32 ValidCells = 0;
+	// 尺寸只取决于全分辨率尺寸，不需要更新降采样层级
+	const int32 Factor = FWorldMorphingLodGrid::GetFactor(FMath::Clamp(Lod, 0, FWorldMorphingLodGrid::NumLevels));
+	const FWorldMorphingGrid& Grid = Subsystem->GetReadGrid();
+	OutWidth = FMath::DivideAndRoundUp(Grid.Width, Factor);
+	OutHeight = FMath::DivideAndRoundUp(Grid.Height, Factor);
+}
 
-	for (int32 Y = 0; Y < GridHeight; ++Y)
+FWorldStatistics UWorldMorphingVisualization::GetStatistics(UObject* WorldContextObject)
+{
+	UWorldMorphingSubsystem* Subsystem = GetWorldMorphingSubsystemForVisualization(WorldContextObject);
+	if (!Subsystem)
 	{
-		for (int32 X = 0; X < GridWidth; ++X)
-		{
-			FCellState Cell = Subsystem->GetCellAt(X, Y);
+		return FWorldStatistics();
+	}
 
-			if (Cell.bExists)
-			{
-				Stats.TerrainCells++;
-				TotalMantleEnergy += Cell.MantleEnergy;
-				TotalTemperature += Cell.Temperature;
-				ValidCells++;
-			}
+	// 统计由子系统在模拟过程中增量维护
+	return Subsystem->GetStatistics();
+}
 
-			// 统计晶石类型
-			switch (Cell.CrystalType)
-			{
-			case ECrystalType::Alpha:
-				Stats.AlphaCrystals++;
-				break;
-			case ECrystalType::Beta:
-				Stats.BetaCrystals++;
-				break;
-			case ECrystalType::Human:
-				Stats.HumanSettlements++;
-				break;
-			default:
-				break;
-			}
+TArray<float> UWorldMorphingVisualization::GetHeatmapData(UObject* WorldContextObject, 
+                                                           EHeatmapDataType DataType,
+                                                           int32 Lod)
+{
+	TArray<float> HeatmapData;
 
-			// 统计雷暴
-			if (Cell.bHasThunderstorm)
-			{
-				Stats.ThunderstormCells++;
-			}
-		}
+	UWorldMorphingSubsystem* Subsystem = GetWorldMorphingSubsystemForVisualization(WorldContextObject);
+	if (!Subsystem)
+	{
+		return HeatmapData;
 	}
 
-	// 计算平均值
-	if (ValidCells > 0)
+	int32 LodWidth = 0;
+	int32 LodHeight = 0;
+	GetLodSize(WorldContextObject, Lod, LodWidth, LodHeight);
+	HeatmapData.SetNumUninitialized(LodWidth * LodHeight);
+	if (!WriteHeatmapData(WorldContextObject, DataType, HeatmapData, Lod))
 	{
-		Stats.AverageMantleEnergy = TotalMantleEnergy / ValidCells;
-		Stats.AverageTemperature = TotalTemperature / ValidCells;
+		HeatmapData.Reset();
 	}
 
-	return Stats;
+	return HeatmapData;
 }
 
-TArray<float> UWorldMorphingVisualization::GetHeatmapData(UObject* WorldContextObject, 
-                                                           EHeatmapDataType DataType)
+bool UWorldMorphingVisualization::WriteHeatmapData(UObject* WorldContextObject, EHeatmapDataType DataType, TArrayView<float> OutHeatmap, int32 Lod)
 {
-	TArray<float> HeatmapData;
+	return WriteSubsystemHeatmapData(GetWorldMorphingSubsystemForVisualization(WorldContextObject), DataType, OutHeatmap, Lod);
+}
 
-	UWorldMorphingSubsystem* Subsystem = GetWorldMorphingSubsystemForVisualization(WorldContextObject);
+bool UWorldMorphingVisualization::WriteSubsystemHeatmapData(const UWorldMorphingSubsystem* Subsystem, EHeatmapDataType DataType, TArrayView<float> OutHeatmap, int32 Lod)
+{
 	if (!Subsystem)
 	{
-		return HeatmapData;
+		return false;
+	}
+
+	// 获取网格尺寸（降采样层级同样是一个网格，读取方式相同）
+	const FWorldMorphingGrid& Grid = Subsystem->GetLodGrid(Lod);
+	const int32 GridWidth = Grid.Width;
+	const int32 GridHeight = Grid.Height;
+	if (OutHeatmap.Num() != GridWidth * GridHeight)
+	{
+		return false;
 	}
 
-	// 获取网格尺寸
-	int32 GridWidth, GridHeight;
-	Subsystem->GetGridSize(GridWidth, GridHeight);
+	// 稀疏层的块级活跃度（调试用）
+	if (DataType == EHeatmapDataType::Activity)
+	{
+		return Subsystem->WriteActivityHeatmap(Lod, OutHeatmap);
+	}
 
-	// 预分配数组
-	HeatmapData.Reserve(GridWidth * GridHeight);
+	// 逐行读取字段平面，写入去掉光晕的行主序缓冲
+	for (int32 Y = 0; Y < GridHeight; ++Y)
+	{
+		NormalizeHeatmapRow(Grid, DataType, Y, 0, GridWidth, OutHeatmap.GetData() + Y * GridWidth);
+	}
+
+	return true;
+}
+
+void UWorldMorphingVisualization::NormalizeHeatmapRow(const FWorldMorphingGrid& Grid, EHeatmapDataType DataType, int32 Y, int32 BeginX, int32 EndX, float* OutRow)
+{
+	const int32 RowStart = Grid.ToIndex(BeginX, Y);
+	const int32 Count = EndX - BeginX;
+	const EWorldCellFlags* Flags = Grid.Flags.GetData() + RowStart;
 
 	// 根据数据类型提取不同的值
 	switch (DataType)
@@ -176,14 +217,11 @@ TArray<float> UWorldMorphingVisualization::GetHeatmapData(UObject* WorldContextO
 		{
 			// 地幔能量热力图（归一化到0-1）
 			const float MaxEnergy = 100.0f; // 假设最大能量为100
-			for (int32 Y = 0; Y < GridHeight; ++Y)
+			const float* MantleEnergy = Grid.MantleEnergy.GetData() + RowStart;
+			for (int32 X = 0; X < Count; ++X)
 			{
-				for (int32 X = 0; X < GridWidth; ++X)
-				{
-					FCellState Cell = Subsystem->GetCellAt(X, Y);
-					float NormalizedValue = Cell.bExists ? (Cell.MantleEnergy / MaxEnergy) : 0.0f;
-					HeatmapData.Add(FMath::Clamp(NormalizedValue, 0.0f, 1.0f));
-				}
+				const bool bExists = EnumHasAnyFlags(Flags[X], EWorldCellFlags::Exists);
+				OutRow[X] = bExists ? FMath::Clamp(MantleEnergy[X] / MaxEnergy, 0.0f, 1.0f) : 0.0f;
 			}
 		}
 		break;
@@ -193,15 +231,11 @@ TArray<float> UWorldMorphingVisualization::GetHeatmapData(UObject* WorldContextO
 			// 温度热力图（归一化到0-1）
 			const float MinTemp = -50.0f;
 			const float MaxTemp = 50.0f;
-			for (int32 Y = 0; Y < GridHeight; ++Y)
+			const float* Temperature = Grid.Temperature.GetData() + RowStart;
+			for (int32 X = 0; X < Count; ++X)
 			{
-				for (int32 X = 0; X < GridWidth; ++X)
-				{
-					FCellState Cell = Subsystem->GetCellAt(X, Y);
-					float NormalizedValue = Cell.bExists ? 
-						((Cell.Temperature - MinTemp) / (MaxTemp - MinTemp)) : 0.0f;
-					HeatmapData.Add(FMath::Clamp(NormalizedValue, 0.0f, 1.0f));
-				}
+				const bool bExists = EnumHasAnyFlags(Flags[X], EWorldCellFlags::Exists);
+				OutRow[X] = bExists ? FMath::Clamp((Temperature[X] - MinTemp) / (MaxTemp - MinTemp), 0.0f, 1.0f) : 0.0f;
 			}
 		}
 		break;
@@ -209,14 +243,10 @@ TArray<float> UWorldMorphingVisualization::GetHeatmapData(UObject* WorldContextO
 	case EHeatmapDataType::CrystalDensity:
 		{
 			// 晶石密度（1=有晶石，0=无晶石）
-			for (int32 Y = 0; Y < GridHeight; ++Y)
+			const ECrystalType* CrystalState = Grid.CrystalState.GetData() + RowStart;
+			for (int32 X = 0; X < Count; ++X)
 			{
-				for (int32 X = 0; X < GridWidth; ++X)
-				{
-					FCellState Cell = Subsystem->GetCellAt(X, Y);
-					float Value = (Cell.CrystalType != ECrystalType::Empty) ? 1.0f : 0.0f;
-					HeatmapData.Add(Value);
-				}
+				OutRow[X] = (CrystalState[X] != ECrystalType::Empty) ? 1.0f : 0.0f;
 			}
 		}
 		break;
@@ -225,21 +255,16 @@ TArray<float> UWorldMorphingVisualization::GetHeatmapData(UObject* WorldContextO
 		{
 			// 人类密度（繁荣度归一化）
 			const float MaxProsperity = 100.0f;
-			for (int32 Y = 0; Y < GridHeight; ++Y)
+			const float* Prosperity = Grid.Prosperity.GetData() + RowStart;
+			for (int32 X = 0; X < Count; ++X)
 			{
-				for (int32 X = 0; X < GridWidth; ++X)
-				{
-					FCellState Cell = Subsystem->GetCellAt(X, Y);
-					float NormalizedValue = Cell.Prosperity / MaxProsperity;
-					HeatmapData.Add(FMath::Clamp(NormalizedValue, 0.0f, 1.0f));
-				}
+				OutRow[X] = FMath::Clamp(Prosperity[X] / MaxProsperity, 0.0f, 1.0f);
 			}
 		}
 		break;
 
 	default:
+		FMemory::Memzero(OutRow, Count * sizeof(float));
 		break;
 	}
-
-	return HeatmapData;
 }
@@ -49,6 +49,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Scene")
 	void SetCenter(FVector InCenter);
 
+	/**
+	 * 获取中心位置
+	 * @return 中心位置（世界坐标）
+	 */
+	UFUNCTION(BlueprintPure, Category = "Combat|Scene")
+	FVector GetCenter() const { return Center; }
+
 	// ========== ISceneManager接口实现 ==========
 	
 	virtual FString GetSceneType() const override { return TEXT("Circular"); }
@@ -63,6 +70,10 @@ public:
 	
 	virtual void HandleBoundaryInteraction(FVector& Position, FVector& Velocity) override;
 	
+	virtual void Advance(TArrayView<FVector> Positions, TArrayView<FVector> Velocities, float DeltaTime) override;
+	
+	virtual void HandleBoundaryInteraction(TArrayView<FVector> Positions, TArrayView<FVector> Velocities) override;
+	
 	// WorldToScreen 和 ScreenToWorld 使用基类 USceneManagerBase 的默认实现
 
 	// ========== 极坐标转换 ==========
@@ -105,6 +116,25 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Combat|Scene")
 	float UpdateEnemyAngle(float CurrentAngle, float AngularVelocity, float DeltaTime) const;
 
+	// ========== 批量运动学 ==========
+	
+	/**
+	 * 批量获取敌人在圆环上的位置（每次处理4个角度，使用SIMD sincos）
+	 * @param Angles 角度数组（弧度）
+	 * @param OutPositions 世界坐标（输出，长度与 Angles 相同）
+	 */
+	void GetEnemyPositions(TConstArrayView<float> Angles, TArrayView<FVector> OutPositions) const;
+
+	/**
+	 * 批量更新敌人角度并输出新位置（角度推进、归一化和 sincos 都按4路SIMD执行）
+	 * 结果与逐个调用 UpdateEnemyAngle + GetEnemyPosition 一致（sincos 为多项式近似，误差约1e-6）
+	 * @param Angles 角度数组（弧度，输入/输出，输出归一化到[0, 2π)）
+	 * @param AngularVelocity 角速度（弧度/秒）
+	 * @param DeltaTime 时间增量（秒）
+	 * @param OutPositions 世界坐标（输出，长度与 Angles 相同）
+	 */
+	void AdvanceEnemyAngles(TArrayView<float> Angles, float AngularVelocity, float DeltaTime, TArrayView<FVector> OutPositions) const;
+
 	// ========== 辅助方法 ==========
 	
 	/**
@@ -111,11 +111,45 @@ public:
 	
 	/**
 	 * 更新集成器
+	 * 
+	 * 每帧的阶段及依赖关系：
+	 * 
+	 *   [游戏线程] 敌人生成队列（会广播事件）
+	 *        |
+	 *   +----+----------------+
+	 *   |                     |
+	 * 魔药积分            敌人移动          （并行：分别只写物理系统 / 敌人列表）
+	 *   |                     |
+	 *   +----+----------------+
+	 *        |
+	 *      宽相             （读取两侧位置，只写碰撞管理器和碰撞体映射）
+	 *        |
+	 *   [游戏线程] 伤害结算（汇合阶段：广播碰撞事件、扣血、计数击杀）
+	 * 
+	 * 敌人生成队列和敌人移动只在 bUpdateEnemies 为 true 时执行（默认由调用方自行调用 UpdateEnemies）。
+	 * bUseTaskGraph 为 false、bUpdateEnemies 为 false（没有可并行的敌人移动）或平台不支持多线程时，
+	 * 按相同顺序在当前线程串行执行。
 	 * @param DeltaTime 时间增量（秒）
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Integration")
 	void Tick(float DeltaTime);
 
+	/**
+	 * 设置是否使用任务图并行更新
+	 * @param bEnable 是否启用
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Integration")
+	void SetUseTaskGraph(bool bEnable) { bUseTaskGraph = bEnable; }
+
+	/**
+	 * 设置集成器是否每帧更新敌人（生成队列 + 移动）
+	 * 启用后调用方不应再调用 UEnemyManager::UpdateEnemies，否则敌人每帧移动两次；
+	 * 只有启用后 Tick 才会使用任务图（敌人移动与魔药积分并行）
+	 * @param bEnable 是否启用
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Integration")
+	void SetUpdateEnemies(bool bEnable) { bUpdateEnemies = bEnable; }
+
 	// ========== 碰撞处理 ==========
 	
 	/**
@@ -135,6 +169,29 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Combat|Integration")
 	bool AreAllMarblesStopped(float SpeedThreshold = 10.0f) const;
 
+	/**
+	 * 获取各魔药类型造成的累计伤害
+	 * @return 魔药类型 -> 累计伤害
+	 */
+	UFUNCTION(BlueprintPure, Category = "Combat|Integration")
+	TMap<EPotionType, float> GetDamageByPotionType() const { return DamageByPotionType; }
+
+	/**
+	 * 获取魔药命中敌人的累计次数
+	 * @return 命中次数
+	 */
+	UFUNCTION(BlueprintPure, Category = "Combat|Integration")
+	int32 GetTotalHitCount() const { return TotalHitCount; }
+
+	/** 获取敌人管理器 */
+	UEnemyManager* GetEnemyManager() const { return EnemyManager; }
+
+	/** 获取物理系统 */
+	UMarblePhysicsSystem* GetPhysicsSystem() const { return PhysicsSystem; }
+
+	/** 获取碰撞管理器 */
+	UCollisionManager* GetCollisionManager() const { return CollisionManager; }
+
 protected:
 	// ========== 系统引用 ==========
 	
@@ -154,6 +211,24 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Combat|Integration")
 	UCollisionManager* CollisionManager = nullptr;
 
+	/** 是否使用任务图并行更新 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat|Integration")
+	bool bUseTaskGraph = true;
+
+	/** 是否由集成器每帧更新敌人 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat|Integration")
+	bool bUpdateEnemies = false;
+
+	// ========== 战斗统计 ==========
+	
+	/** 各魔药类型造成的累计伤害 */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat|Integration")
+	TMap<EPotionType, float> DamageByPotionType;
+
+	/** 魔药命中敌人的累计次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat|Integration")
+	int32 TotalHitCount = 0;
+
 	// ========== 碰撞体映射 ==========
 	
 	/** 魔药ID到碰撞体ID的映射 */
@@ -186,9 +261,29 @@ protected:
 	void UpdateCollisionBodies();
 
 	/**
-	 * 检测碰撞
+	 * 串行执行一帧的所有阶段
+	 * @param DeltaTime 时间增量（秒）
+	 */
+	void TickSerial(float DeltaTime);
+
+	/**
+	 * 使用任务图执行一帧的所有阶段（见 Tick 的依赖图）
+	 * 要求 EnemyManager 有效且 bUpdateEnemies 为 true
+	 * @param DeltaTime 时间增量（秒）
+	 */
+	void TickTaskGraph(float DeltaTime);
+
+	/**
+	 * 检测碰撞（不广播事件，可在工作线程调用）
+	 * @param OutCollisions 碰撞事件（输出）
+	 */
+	void DetectCollisions(TArray<FEchoCollisionEvent>& OutCollisions);
+
+	/**
+	 * 伤害结算：广播碰撞事件并处理每个碰撞（必须在游戏线程调用）
+	 * @param Collisions 碰撞事件
 	 */
-	void DetectCollisions();
+	void ResolveCollisions(const TArray<FEchoCollisionEvent>& Collisions);
 
 	/**
 	 * 处理魔药与敌人的碰撞
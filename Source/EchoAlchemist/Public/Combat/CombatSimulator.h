@@ -0,0 +1,245 @@
+// Copyright Echo Alchemist Game. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "CombatConfig.h"
+#include "CombatSceneTypes.h"
+#include "EnemyData.h"
+#include "Physics/MarbleState.h"
+#include "CombatSimulator.generated.h"
+
+class UCombatManager;
+
+/**
+ * 战斗模拟参数
+ * 描述一场无画面战斗的规则和玩家行为（按固定间隔向最近的敌人发射魔药）
+ */
+USTRUCT(BlueprintType)
+struct ECHOALCHEMIST_API FCombatSimulationParams
+{
+	GENERATED_BODY()
+
+	// ========== 战斗配置 ==========
+
+	/** 战斗配置（敌人数量、生成间隔、胜利条件、难度倍率） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation")
+	FCombatConfig Config;
+
+	/** 场景类型 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation")
+	ECombatSceneType SceneType = ECombatSceneType::Circular;
+
+	/** 敌人类型 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation")
+	EEnemyType EnemyType = EEnemyType::CrystalGolem;
+
+	/** 敌人基础生命值（会乘以 Config.EnemyHealthMultiplier） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation", meta = (ClampMin = "1.0"))
+	float EnemyMaxHealth = 100.0f;
+
+	// ========== 时间 ==========
+
+	/** 模拟时长上限（秒，战斗提前结束时停止） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation", meta = (ClampMin = "0.0"))
+	float DurationSeconds = 120.0f;
+
+	/** 固定时间步长（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation", meta = (ClampMin = "0.001"))
+	float TimeStep = 1.0f / 60.0f;
+
+	/** 随机种子（批量模拟时第 i 场使用 RandomSeed + i） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation")
+	int32 RandomSeed = 0;
+
+	// ========== 玩家行为 ==========
+
+	/** 发射间隔（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Player", meta = (ClampMin = "0.01"))
+	float LaunchInterval = 1.0f;
+
+	/** 魔药配置（按顺序循环发射，为空时只发射弹射药剂） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Player")
+	TArray<EPotionType> PotionLoadout;
+
+	/** 发射位置 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Player")
+	FVector LaunchPosition = FVector::ZeroVector;
+
+	/** 发射速度（cm/s） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Player", meta = (ClampMin = "0.0"))
+	float LaunchSpeed = 1000.0f;
+
+	/** 初始药效倍率 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Player", meta = (ClampMin = "0.0"))
+	float PotencyMultiplier = 5.0f;
+
+	/** 同时存在的魔药数量上限 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Player", meta = (ClampMin = "1"))
+	int32 MaxActiveMarbles = 20;
+
+	// ========== 性能 ==========
+
+	/** 模拟期间屏蔽 LogTemp 的 Log 级别日志（只保留警告和错误） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation|Performance")
+	bool bSuppressLogging = true;
+};
+
+/**
+ * 单场战斗模拟结果
+ */
+USTRUCT(BlueprintType)
+struct ECHOALCHEMIST_API FCombatSimulationResult
+{
+	GENERATED_BODY()
+
+	/** 使用的随机种子 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	int32 Seed = 0;
+
+	/** 是否胜利 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	bool bVictory = false;
+
+	/** 击杀数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	int32 Kills = 0;
+
+	/** 模拟的战斗时间（秒，胜利时即为胜利用时） */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	float CombatTime = 0.0f;
+
+	/** 发射的魔药数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	int32 MarblesLaunched = 0;
+
+	/** 命中次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	int32 Hits = 0;
+
+	/** 各魔药类型造成的伤害 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	TMap<EPotionType, float> DamageByPotionType;
+};
+
+/**
+ * 批量战斗模拟的汇总统计
+ */
+USTRUCT(BlueprintType)
+struct ECHOALCHEMIST_API FCombatSimulationStats
+{
+	GENERATED_BODY()
+
+	/** 模拟场数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	int32 RunCount = 0;
+
+	/** 胜利场数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	int32 VictoryCount = 0;
+
+	/** 胜率（0-1） */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	float WinRate = 0.0f;
+
+	/** 平均击杀数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	float AverageKills = 0.0f;
+
+	/** 平均胜利用时（秒，只统计胜利场次） */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	float AverageTimeToVictory = 0.0f;
+
+	/** 最短胜利用时（秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	float MinTimeToVictory = 0.0f;
+
+	/** 最长胜利用时（秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	float MaxTimeToVictory = 0.0f;
+
+	/** 各魔药类型的场均伤害 */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	TMap<EPotionType, float> AverageDamageByPotionType;
+
+	/** 总模拟时间（秒，游戏内时间） */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	float TotalSimulatedSeconds = 0.0f;
+
+	/** 实际耗时（秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "Simulation")
+	float WallClockSeconds = 0.0f;
+};
+
+/**
+ * 无画面战斗模拟器
+ *
+ * 用 UCombatSystemInitializer 搭建完整的战斗栈（战斗管理器、敌人管理器、物理系统、碰撞管理器），
+ * 以固定步长尽可能快地推进战斗，用于数值平衡和AI前瞻。
+ *
+ * 设计要点：
+ * - 不创建Actor、不使用Niagara，可选屏蔽日志
+ * - 每场战斗使用独立的战斗栈和随机流，多场战斗在工作线程上并行执行
+ * - 战斗栈在游戏线程分批创建；工作线程运行期间游戏线程阻塞在 ParallelFor 中，不会发生GC
+ * - 集成器在模拟中串行更新（并行度来自多场战斗，而不是单场内部）
+ *
+ * 使用示例：
+ * ```
+ * FCombatSimulationParams Params;
+ * Params.Config = FCombatConfig::CreateNormalConfig();
+ * Params.PotionLoadout = { EPotionType::Ricochet, EPotionType::Explosive };
+ *
+ * TArray<FCombatSimulationResult> Results;
+ * FCombatSimulationStats Stats = UCombatSimulator::SimulateCombatBatch(Params, 1000, Results);
+ * ```
+ */
+UCLASS()
+class ECHOALCHEMIST_API UCombatSimulator : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * 模拟单场战斗（在当前线程执行）
+	 * @param Params 模拟参数
+	 * @return 模拟结果
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Simulation")
+	static FCombatSimulationResult SimulateCombat(const FCombatSimulationParams& Params);
+
+	/**
+	 * 并行模拟多场独立战斗（必须在游戏线程调用）
+	 * @param Params 模拟参数（第 i 场使用种子 RandomSeed + i）
+	 * @param RunCount 模拟场数
+	 * @param OutResults 每场的结果（输出，按场次顺序）
+	 * @return 汇总统计
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Simulation")
+	static FCombatSimulationStats SimulateCombatBatch(const FCombatSimulationParams& Params, int32 RunCount, TArray<FCombatSimulationResult>& OutResults);
+
+	/**
+	 * 汇总多场模拟结果
+	 * @param Results 模拟结果
+	 * @return 汇总统计（不含实际耗时）
+	 */
+	UFUNCTION(BlueprintPure, Category = "Combat|Simulation")
+	static FCombatSimulationStats AggregateResults(const TArray<FCombatSimulationResult>& Results);
+
+private:
+	/**
+	 * 搭建一场战斗的战斗栈并开始战斗（必须在游戏线程调用）
+	 * @param Params 模拟参数
+	 * @return 战斗管理器（失败时为nullptr）
+	 */
+	static UCombatManager* CreateCombat(const FCombatSimulationParams& Params);
+
+	/**
+	 * 运行一场已开始的战斗直到结束或达到时长上限（可在工作线程调用）
+	 * @param CombatManager 战斗管理器
+	 * @param Params 模拟参数
+	 * @param Seed 随机种子
+	 * @return 模拟结果
+	 */
+	static FCombatSimulationResult RunCombat(UCombatManager* CombatManager, const FCombatSimulationParams& Params, int32 Seed);
+};
@@ -77,6 +77,10 @@ struct ECHOALCHEMIST_API FEnemyData
 	UPROPERTY(BlueprintReadWrite, Category = "Transform")
 	float MoveSpeed = 100.0f;
 
+	/** 环形场景中的角度（弧度，每帧更新；ExtraData["Angle"] 只在生成和查询复制时同步） */
+	UPROPERTY(BlueprintReadWrite, Category = "Transform")
+	float Angle = 0.0f;
+
 	// ========== 生命值 ==========
 	
 	/** 当前生命值 */
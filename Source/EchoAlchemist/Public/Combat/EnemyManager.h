@@ -7,8 +7,36 @@
 #include "EnemyData.h"
 #include "SceneManager.h"
 #include "CombatEvents.h"
+#include "EnemySpatialIndex.h"
 #include "EnemyManager.generated.h"
 
+class UCircularSceneManager;
+
+/**
+ * 待生成的敌人波次
+ * 一个波次的生成被分摊到多帧完成，避免大波次在单帧内集中分配
+ */
+struct FPendingEnemyWave
+{
+	/** 波次序号（入队时分配，用于识别回调中队列是否被改动） */
+	int32 WaveID = 0;
+
+	/** 敌人类型 */
+	EEnemyType EnemyType = EEnemyType::CrystalGolem;
+
+	/** 最大生命值 */
+	float MaxHealth = 100.0f;
+
+	/** 波次总数量 */
+	int32 TotalCount = 0;
+
+	/** 已生成数量 */
+	int32 SpawnedCount = 0;
+
+	/** 剩余可用帧数 */
+	int32 FramesLeft = 1;
+};
+
 /**
  * 敌人管理器
  * 负责敌人的生成、更新、死亡、移除
@@ -76,6 +104,57 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Enemy")
 	TArray<FGuid> SpawnEnemies(EEnemyType EnemyType, int32 Count, float MaxHealth);
 
+	// ========== 波次生成（对象池） ==========
+	
+	/**
+	 * 加入一个待生成的波次
+	 * 敌人会在之后的 UpdateEnemies / ProcessSpawnQueue 中分帧生成，
+	 * 数据槽位从对象池中复用，属性从该类型的模板中拷贝
+	 * @param EnemyType 敌人类型
+	 * @param Count 数量
+	 * @param MaxHealth 最大生命值
+	 * @param SpreadFrames 分摊帧数（<=0 时使用 DefaultWaveSpawnFrames）
+	 * @return 实际加入队列的数量
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Enemy|Wave")
+	int32 QueueWave(EEnemyType EnemyType, int32 Count, float MaxHealth, int32 SpreadFrames = 0);
+
+	/**
+	 * 处理生成队列（生成本帧配额内的敌人）
+	 * @return 本帧生成的敌人数量
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Enemy|Wave")
+	int32 ProcessSpawnQueue();
+
+	/**
+	 * 获取尚未生成的敌人数量
+	 * @return 队列中待生成的敌人数量
+	 */
+	UFUNCTION(BlueprintPure, Category = "Combat|Enemy|Wave")
+	int32 GetPendingSpawnCount() const;
+
+	/**
+	 * 预分配敌人对象池
+	 * @param Capacity 预分配的槽位数量
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Enemy|Wave")
+	void ReserveEnemyPool(int32 Capacity);
+
+	/**
+	 * 设置敌人类型模板（名称、碰撞、属性表等）
+	 * @param EnemyType 敌人类型
+	 * @param Template 模板数据（ID、位置、生命值会在生成时覆盖）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Enemy|Wave")
+	void SetEnemyTemplate(EEnemyType EnemyType, const FEnemyData& Template);
+
+	/**
+	 * 获取对象池中可复用的槽位数量
+	 * @return 空闲槽位数量
+	 */
+	UFUNCTION(BlueprintPure, Category = "Combat|Enemy|Wave")
+	int32 GetPooledEnemyCount() const { return EnemyPool.Num(); }
+
 	// ========== 敌人更新 ==========
 	
 	/**
@@ -85,6 +164,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Enemy")
 	void UpdateEnemies(float DeltaTime);
 
+	/**
+	 * 更新所有活跃敌人的移动和攻击（不处理生成队列）
+	 * 
+	 * 不广播事件、不创建对象，只写敌人列表，因此可以在工作线程上与魔药积分并行执行。
+	 * UpdateEnemies = ProcessSpawnQueue + UpdateEnemyMovement。
+	 * @param DeltaTime 时间增量（秒）
+	 */
+	void UpdateEnemyMovement(float DeltaTime);
+
 	/**
 	 * 更新单个敌人
 	 * @param Enemy 敌人数据（输入/输出）
@@ -167,6 +255,60 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Combat|Enemy")
 	bool GetNearestEnemy(const FVector& Position, FEnemyData& OutEnemy) const;
 
+	// ========== 空间查询 ==========
+	
+	/**
+	 * 获取半径内的所有存活敌人
+	 * @param Position 参考位置
+	 * @param Radius 查询半径（cm）
+	 * @return 敌人列表
+	 */
+	UFUNCTION(BlueprintPure, Category = "Combat|Enemy|Query")
+	TArray<FEnemyData> GetEnemiesInRadius(const FVector& Position, float Radius) const;
+
+	/**
+	 * 获取最近的N个存活敌人（从近到远）
+	 * @param Position 参考位置
+	 * @param Count 数量
+	 * @param MaxRadius 最大搜索半径（cm，<=0 表示不限制）
+	 * @return 敌人列表
+	 */
+	UFUNCTION(BlueprintPure, Category = "Combat|Enemy|Query")
+	TArray<FEnemyData> GetNearestEnemies(const FVector& Position, int32 Count, float MaxRadius = 0.0f) const;
+
+	/**
+	 * 查询半径内的存活敌人下标（不拷贝敌人数据）
+	 * @param Position 参考位置
+	 * @param Radius 查询半径（cm）
+	 * @param OutIndices 敌人下标（输出，可配合 GetEnemyAtIndex 使用）
+	 * @return 找到的数量
+	 */
+	int32 QueryEnemiesInRadius(const FVector& Position, float Radius, TArray<int32>& OutIndices) const;
+
+	/**
+	 * 查询最近的K个存活敌人下标（不拷贝敌人数据，从近到远）
+	 * @param Position 参考位置
+	 * @param K 数量
+	 * @param MaxRadius 最大搜索半径（cm，<=0 表示不限制）
+	 * @param OutIndices 敌人下标（输出）
+	 * @return 找到的数量
+	 */
+	int32 QueryNearestEnemies(const FVector& Position, int32 K, float MaxRadius, TArray<int32>& OutIndices) const;
+
+	/**
+	 * 根据下标获取敌人数据
+	 * @param Index 敌人下标（来自 Query* 的结果，敌人列表变化后失效）
+	 * @return 敌人数据
+	 */
+	const FEnemyData& GetEnemyAtIndex(int32 Index) const { return Enemies[Index]; }
+
+	/**
+	 * 立即重建空间索引
+	 * 查询会在索引过期时自动重建；在多个线程同时查询之前，应先在游戏线程调用一次
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Enemy|Query")
+	void RebuildSpatialIndex();
+
 	// ========== 事件系统 ==========
 	
 	/**
@@ -207,6 +349,61 @@ protected:
 	UPROPERTY(BlueprintReadWrite, Category = "Combat|Enemy")
 	float EnemyAttackInterval = 2.0f;
 
+	// ========== 波次生成 ==========
+	
+	/** 波次默认分摊帧数 */
+	UPROPERTY(BlueprintReadWrite, Category = "Combat|Enemy|Wave")
+	int32 DefaultWaveSpawnFrames = 4;
+
+	/** 每种敌人类型的模板 */
+	UPROPERTY(BlueprintReadOnly, Category = "Combat|Enemy|Wave")
+	TMap<EEnemyType, FEnemyData> EnemyTemplates;
+
+	/** 已回收的敌人数据（保留属性表的内存，供下次生成复用） */
+	TArray<FEnemyData> EnemyPool;
+
+	/** 待生成的波次队列 */
+	TArray<FPendingEnemyWave> PendingWaves;
+
+	/** 下一个波次序号 */
+	int32 NextWaveID = 0;
+
+	/** 池化ID的基础值（每次初始化生成一次） */
+	FGuid PooledIDBase;
+
+	/** 池化ID的序号 */
+	uint32 PooledIDSerial = 0;
+
+	// ========== 空间索引 ==========
+	
+	/** 环形场景的角度扇区数量 */
+	UPROPERTY(BlueprintReadWrite, Category = "Combat|Enemy|Query")
+	int32 SpatialIndexAngularBuckets = 64;
+
+	/** 下落式场景的网格单元尺寸（cm） */
+	UPROPERTY(BlueprintReadWrite, Category = "Combat|Enemy|Query")
+	float SpatialIndexCellSize = 100.0f;
+
+	/** 敌人空间索引（查询时按需重建） */
+	mutable FEnemySpatialIndex SpatialIndex;
+
+	/** 空间索引是否过期 */
+	mutable bool bSpatialIndexDirty = true;
+
+	/** 保护按需重建（多个线程可能同时查询过期的索引） */
+	mutable FCriticalSection SpatialIndexLock;
+
+	// ========== 批量移动缓冲 ==========
+	
+	/** 本帧参与批量移动的敌人下标 */
+	TArray<int32> MovementIndices;
+
+	/** 批量移动的角度 */
+	TArray<float> MovementAngles;
+
+	/** 批量移动输出的位置 */
+	TArray<FVector> MovementPositions;
+
 	// ========== 内部方法 ==========
 	
 	/**
@@ -223,6 +420,14 @@ protected:
 	 */
 	void UpdateEnemyMovementCircular(FEnemyData& Enemy, float DeltaTime);
 
+	/**
+	 * 批量更新所有活跃敌人的移动（环形场景）
+	 * 收集角度后一次调用 UCircularSceneManager::AdvanceEnemyAngles
+	 * @param CircularScene 环形场景
+	 * @param DeltaTime 时间增量（秒）
+	 */
+	void UpdateEnemyMovementCircularBatch(const UCircularSceneManager* CircularScene, float DeltaTime);
+
 	/**
 	 * 更新敌人攻击
 	 * @param Enemy 敌人数据（输入/输出）
@@ -230,6 +435,48 @@ protected:
 	 */
 	void UpdateEnemyAttack(FEnemyData& Enemy, float DeltaTime);
 
+	/**
+	 * 从对象池中取出一个敌人槽位并按模板初始化
+	 * @param EnemyType 敌人类型
+	 * @param Position 位置
+	 * @param MaxHealth 最大生命值
+	 * @return 已加入敌人列表的敌人数据
+	 */
+	FEnemyData& AcquireEnemy(EEnemyType EnemyType, const FVector& Position, float MaxHealth);
+
+	/**
+	 * 将敌人数据回收到对象池
+	 * @param Enemy 敌人数据（会被移动）
+	 */
+	void ReleaseEnemy(FEnemyData&& Enemy);
+
+	/**
+	 * 生成下一个池化ID
+	 * @return 在本管理器内唯一的ID
+	 */
+	FGuid MakePooledID();
+
+	/**
+	 * 构建默认的敌人类型模板
+	 */
+	void BuildDefaultEnemyTemplates();
+
+	/**
+	 * 计算波次中第Index个敌人的生成位置
+	 * @param Index 序号
+	 * @param Count 波次总数量
+	 * @param CircularScene 环形场景（下落式场景为nullptr）
+	 * @param OutAngle 角度（弧度，仅环形场景，输出）
+	 * @return 生成位置
+	 */
+	FVector GetWaveSpawnPosition(int32 Index, int32 Count, const UCircularSceneManager* CircularScene, float& OutAngle) const;
+
+	/**
+	 * 如果空间索引过期则重建（在锁内检查和重建，可以从多个线程同时调用；
+	 * 修改敌人列表的函数仍然只能在拥有者线程上、没有并发查询时调用）
+	 */
+	void EnsureSpatialIndex() const;
+
 	/**
 	 * 根据ID查找敌人索引
 	 * @param EnemyID 敌人ID
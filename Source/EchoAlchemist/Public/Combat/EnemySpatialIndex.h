@@ -0,0 +1,168 @@
+// Copyright Echo Alchemist Game. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 敌人空间索引
+ * 
+ * 为目标选择（最近敌人、分裂、连锁触发、追踪）提供范围查询和K近邻查询，
+ * 避免每个魔药查询都遍历全部敌人。
+ * 
+ * 两种分桶方式：
+ * - 角度分桶：环形场景中敌人分布在圆环上，按极角划分为若干扇区
+ * - 网格分桶：下落式场景使用XY平面上的均匀网格（网格范围由敌人位置包围盒决定）
+ * 
+ * 数据布局：
+ * - 每次重建时对敌人做一次计数排序，同一个桶内的敌人在内存中连续存放
+ * - 重建为 O(n)，查询只访问查询范围覆盖的桶
+ * 
+ * 注意事项：
+ * - 索引只保存敌人在 UEnemyManager::Enemies 中的下标，敌人列表变化后必须重建
+ * - 分桶只使用XY平面，最终距离判断使用完整的三维距离，结果是精确的
+ * - 重建后索引只读，多个线程可以同时查询
+ */
+class FEnemySpatialIndex
+{
+public:
+	/** 分桶方式 */
+	enum class EMode : uint8
+	{
+		Angular,	// 角度分桶（环形场景）
+		Grid		// 网格分桶（下落式场景）
+	};
+
+	FEnemySpatialIndex();
+
+	/**
+	 * 开始以角度分桶方式重建
+	 * 
+	 * @param InCenter 圆环中心（世界坐标）
+	 * @param InBucketCount 扇区数量
+	 */
+	void BeginAngular(const FVector& InCenter, int32 InBucketCount);
+
+	/**
+	 * 开始以网格分桶方式重建
+	 * 
+	 * @param InCellSize 网格单元尺寸（单位：cm）
+	 */
+	void BeginGrid(float InCellSize);
+
+	/**
+	 * 添加敌人（必须在 Begin* 与 Finalize 之间调用）
+	 * 
+	 * @param EnemyIndex 敌人在敌人列表中的下标
+	 * @param Position 敌人位置
+	 * @param Angle 敌人极角（弧度，仅角度分桶使用，由场景的 CartesianToPolar 计算）
+	 */
+	void Add(int32 EnemyIndex, const FVector& Position, float Angle = 0.0f);
+
+	/**
+	 * 完成重建（计数排序到各个桶）
+	 */
+	void Finalize();
+
+	/**
+	 * 清空索引
+	 */
+	void Reset();
+
+	/**
+	 * 查询半径内的敌人
+	 * 
+	 * @param Position 查询位置
+	 * @param Radius 查询半径
+	 * @param OutIndices 输出参数，敌人下标（会先清空）
+	 * @return 找到的敌人数量
+	 */
+	int32 QueryRadius(const FVector& Position, float Radius, TArray<int32>& OutIndices) const;
+
+	/**
+	 * 查询最近的K个敌人（按距离从近到远排序）
+	 * 
+	 * @param Position 查询位置
+	 * @param K 数量
+	 * @param MaxRadius 最大搜索半径（<=0 表示不限制）
+	 * @param OutIndices 输出参数，敌人下标（会先清空）
+	 * @return 找到的敌人数量
+	 */
+	int32 QueryKNearest(const FVector& Position, int32 K, float MaxRadius, TArray<int32>& OutIndices) const;
+
+	/** 索引中的敌人数量 */
+	int32 Num() const { return Entries.Num(); }
+
+	/** 当前分桶方式 */
+	EMode GetMode() const { return Mode; }
+
+private:
+	/** 索引条目 */
+	struct FEntry
+	{
+		FVector Position;
+		int32 EnemyIndex;
+		int32 Bucket;
+	};
+
+	/** 候选结果（K近邻使用） */
+	struct FCandidate
+	{
+		float DistSquared;
+		int32 EnemyIndex;
+	};
+
+	/** 分桶方式 */
+	EMode Mode = EMode::Angular;
+
+	/** 圆环中心（角度分桶） */
+	FVector Center = FVector::ZeroVector;
+
+	/** 扇区宽度（弧度，角度分桶） */
+	float BucketAngle = 0.0f;
+
+	/** 网格单元尺寸（网格分桶） */
+	float CellSize = 100.0f;
+
+	/** 网格原点（网格分桶） */
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+
+	/** 网格维度（网格分桶） */
+	FIntPoint GridDimensions = FIntPoint(1, 1);
+
+	/** 桶数量 */
+	int32 BucketCount = 1;
+
+	/** 每个桶在 Entries 中的起始位置（长度为 BucketCount + 1） */
+	TArray<int32> BucketStart;
+
+	/** 按桶排序后的条目 */
+	TArray<FEntry> Entries;
+
+	/** 重建过程中暂存的条目 */
+	TArray<FEntry> Staging;
+
+	/** 暂存条目的极角（角度分桶） */
+	TArray<float> StagingAngles;
+
+	/** 计数排序的写入游标 */
+	TArray<int32> WriteCursor;
+
+	/** 角度转扇区 */
+	int32 AngleToBucket(float Angle) const;
+
+	/** XY坐标转网格坐标（不做范围限制） */
+	FIntPoint PositionToCell(const FVector& Position) const;
+
+	/** 检查一个桶中的条目并更新K近邻候选（候选堆为最大堆，堆顶是当前第K近） */
+	void GatherBucket(int32 Bucket, const FVector& Position, int32 K, float MaxDistSquared, TArray<FCandidate>& Heap) const;
+
+	/** 当前第K个候选的距离平方（候选不足K个时返回MaxDistSquared） */
+	static float KthDistSquared(const TArray<FCandidate>& Heap, int32 K, float MaxDistSquared);
+
+	/** 角度分桶的K近邻：从查询点所在扇区向两侧扩展 */
+	void QueryKNearestAngular(const FVector& Position, int32 K, float MaxDistSquared, TArray<FCandidate>& Heap) const;
+
+	/** 网格分桶的K近邻：从查询点所在网格按环向外扩展 */
+	void QueryKNearestGrid(const FVector& Position, int32 K, float MaxDistSquared, TArray<FCandidate>& Heap) const;
+};
@@ -45,6 +45,10 @@ public:
 
 	// ========== ISceneManager接口实现 ==========
 	
+	// 批量版本使用接口的默认实现
+	using USceneManagerBase::Advance;
+	using USceneManagerBase::HandleBoundaryInteraction;
+	
 	virtual FString GetSceneType() const override { return TEXT("Falling"); }
 	
 	virtual void Advance(FVector& Position, FVector& Velocity, float DeltaTime) override;
@@ -48,6 +48,22 @@ public:
 	 */
 	virtual void Advance(FVector& Position, FVector& Velocity, float DeltaTime) = 0;
 
+	/**
+	 * 批量更新位置和速度
+	 * 默认实现逐个调用单个版本，场景可重写为批量实现
+	 * @param Positions 位置数组（输入/输出）
+	 * @param Velocities 速度数组（输入/输出，长度与 Positions 相同）
+	 * @param DeltaTime 时间增量（秒）
+	 */
+	virtual void Advance(TArrayView<FVector> Positions, TArrayView<FVector> Velocities, float DeltaTime)
+	{
+		check(Positions.Num() == Velocities.Num());
+		for (int32 i = 0; i < Positions.Num(); ++i)
+		{
+			Advance(Positions[i], Velocities[i], DeltaTime);
+		}
+	}
+
 	/**
 	 * 获取发射向量
 	 * @param StartPosition 起始位置
@@ -79,6 +95,21 @@ public:
 	 */
 	virtual void HandleBoundaryInteraction(FVector& Position, FVector& Velocity) = 0;
 
+	/**
+	 * 批量处理边界交互
+	 * 默认实现逐个调用单个版本，场景可重写为批量实现
+	 * @param Positions 位置数组（输入/输出）
+	 * @param Velocities 速度数组（输入/输出，长度与 Positions 相同）
+	 */
+	virtual void HandleBoundaryInteraction(TArrayView<FVector> Positions, TArrayView<FVector> Velocities)
+	{
+		check(Positions.Num() == Velocities.Num());
+		for (int32 i = 0; i < Positions.Num(); ++i)
+		{
+			HandleBoundaryInteraction(Positions[i], Velocities[i]);
+		}
+	}
+
 	// ========== 坐标转换 ==========
 	
 	/**
@@ -34,6 +34,10 @@ public:
 
 	// ========== ISceneManager 接口默认实现 ==========
 	
+	// 保持接口中批量重载可见（重写单个版本会隐藏同名重载）
+	using ISceneManager::Advance;
+	using ISceneManager::HandleBoundaryInteraction;
+	
 	/**
 	 * 默认坐标转换：逻辑坐标 = 屏幕坐标
 	 */
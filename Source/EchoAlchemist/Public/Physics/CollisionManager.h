@@ -204,6 +204,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Physics|Collision")
 	TArray<FEchoCollisionEvent> DetectCollisions();
 
+	/**
+	 * 执行碰撞检测，但不触发OnCollision事件
+	 * 
+	 * @param OutCollisions 输出参数，存储碰撞事件（会先清空）
+	 * @return 碰撞数量
+	 * 
+	 * 注意事项：
+	 * - 只读取碰撞体和空间网格，不广播委托，可在工作线程调用
+	 * - 调用方需在游戏线程用 BroadcastCollisionEvents 补发事件
+	 */
+	int32 DetectCollisionsDeferred(TArray<FEchoCollisionEvent>& OutCollisions);
+
+	/**
+	 * 触发OnCollision事件（用于补发 DetectCollisionsDeferred 的结果）
+	 * 
+	 * @param Collisions 碰撞事件
+	 * 
+	 * 注意事项：
+	 * - 必须在游戏线程调用
+	 */
+	void BroadcastCollisionEvents(const TArray<FEchoCollisionEvent>& Collisions);
+
 	/**
 	 * 检测指定碰撞体与其他碰撞体的碰撞
 	 * 
@@ -213,6 +213,10 @@ struct FMarbleLaunchParams
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lifecycle", meta = (ClampMin = "0.0"))
 	float BaseDamage = 10.0f;
 
+	/** 魔药类型（仅战斗场景） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Potion")
+	EPotionType PotionType = EPotionType::Ricochet;
+
 	// ========== 分级降级 ==========
 	
 	/** 代数（0=玩家发射，1=第一次分裂，2+=粒子优化） */
@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 块级活跃度
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+
+/**
+ * 块级活跃度位图
+ *
+ * 网格按 TileSize x TileSize 分块，记录哪些块包含活跃单元格（如 Alpha 晶石、人类聚落）。
+ * 稀疏的层只遍历“处理集合”中的块：当前活跃块和上一步活跃块（让刚失去活跃单元格的块再清理一次），
+ * 再向外扩展 Dilation 个块以覆盖活跃单元格的一圈邻居。
+ *
+ * 刷新只重新扫描上一步被标记或处理过的块；其他块中的活跃单元格只能由处理中的块产生，
+ * 或者由调用方通过 MarkCell 显式标记，因此开销与活跃面积成正比。
+ */
+class ECHOALCHEMIST_API FWorldMorphingActivityMap
+{
+public:
+	// 块边长（与子系统的条带行数一致，一行块正好是一个条带）
+	static constexpr int32 TileSize = 16;
+
+	/**
+	 * 按网格尺寸分配，所有块标记为活跃（第一次刷新时全部扫描）
+	 */
+	void Init(int32 InWidth, int32 InHeight);
+
+	/** 释放 */
+	void Reset();
+
+	/**
+	 * 重新计算活跃块和处理集合
+	 * @param Grid 网格
+	 * @param IsActiveCell 判断单元格是否活跃
+	 * @param Dilation 处理集合向外扩展的块数
+	 */
+	void Refresh(const FWorldMorphingGrid& Grid, TFunctionRef<bool(int32 Index)> IsActiveCell, int32 Dilation);
+
+	/**
+	 * 标记某个单元格变为活跃（在处理集合之外产生活跃单元格时调用）
+	 */
+	void MarkCell(const FWorldMorphingGrid& Grid, int32 Index);
+
+	/** 是否有活跃块 */
+	bool HasActiveTiles() const { return Active.Contains(1); }
+
+	/**
+	 * 遍历某一行块中处理集合内的单元格
+	 * 相邻的处理块在每个单元格行上合并为一个连续区间 [BeginIndex, EndIndex)
+	 */
+	void ForEachSpan(const FWorldMorphingGrid& Grid, int32 TileY, TFunctionRef<void(int32 BeginIndex, int32 EndIndex)> Body) const;
+
+	int32 GetTilesX() const { return TilesX; }
+	int32 GetTilesY() const { return TilesY; }
+
+	/** 块是否包含活跃单元格 */
+	bool IsActive(int32 TileX, int32 TileY) const { return Active[TileY * TilesX + TileX] != 0; }
+
+	/** 块是否在处理集合中 */
+	bool IsProcessed(int32 TileX, int32 TileY) const { return Processed[TileY * TilesX + TileX] != 0; }
+
+private:
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 TilesX = 0;
+	int32 TilesY = 0;
+
+	// 包含活跃单元格的块
+	TArray<uint8> Active;
+
+	// 上一次刷新时活跃的块
+	TArray<uint8> Previous;
+
+	// 本步处理的块
+	TArray<uint8> Processed;
+
+	/** 块内是否有活跃单元格 */
+	bool TileHasActiveCell(const FWorldMorphingGrid& Grid, int32 TileX, int32 TileY, TFunctionRef<bool(int32 Index)> IsActiveCell) const;
+};
@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 分块网格布局
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+
+/**
+ * 世界网格的一个块（32x32 个单元格，四周一圈光晕）
+ *
+ * 所有字段平面存放在同一次分配中（约30KB），适合按块处理时放进缓存，
+ * 也可以整块换出/换入。块内下标布局与 FWorldMorphingGrid 相同（行跨度 Pitch，光晕在四周），
+ * 扩散内核等只依赖下标偏移的代码可以直接在块上运行。
+ */
+struct ECHOALCHEMIST_API FWorldMorphingChunk
+{
+	// 块边长
+	static constexpr int32 Size = 32;
+
+	// 块内行跨度（含光晕）
+	static constexpr int32 Pitch = Size + 2;
+
+	// 块内单元格总数（含光晕）
+	static constexpr int32 CellCount = Pitch * Pitch;
+
+	// 8邻域下标偏移（与 FWorldMorphingGrid::NeighborOffsets 同序）
+	static constexpr int32 NeighborOffsets[8] = { -Pitch - 1, -Pitch, -Pitch + 1, -1, 1, Pitch - 1, Pitch, Pitch + 1 };
+
+	// 块坐标
+	int32 ChunkX = 0;
+	int32 ChunkY = 0;
+
+	// ========== 字段平面 ==========
+	EWorldCellFlags Flags[CellCount];
+	ECrystalType CrystalState[CellCount];
+	float MantleEnergy[CellCount];
+	float Temperature[CellCount];
+	float TemperatureChange[CellCount];
+	float CrystalEnergy[CellCount];
+	float StoredEnergy[CellCount];
+	float Prosperity[CellCount];
+
+	/** 块内坐标（-1..Size，含光晕）转换为块内下标 */
+	static FORCEINLINE int32 ToLocalIndex(int32 LocalX, int32 LocalY) { return (LocalY + 1) * Pitch + (LocalX + 1); }
+
+	/**
+	 * 把单元格重置为默认值（与 FWorldMorphingGrid::Init 一致）
+	 * @param bValid 是否位于世界内部
+	 */
+	void ResetCell(int32 Index, bool bValid);
+
+	/** 从另一个块复制一个单元格的全部字段 */
+	void CopyCell(int32 Index, const FWorldMorphingChunk& Source, int32 SourceIndex);
+
+	/** 块内是否有存在的地形（不含光晕） */
+	bool HasLand() const;
+};
+
+/**
+ * 分块世界网格
+ *
+ * 世界按 32x32 分块，只有包含地形的块才分配内存，海洋块不占空间；
+ * 长期运行后世界远超初始圆盘时，内存与地形面积成正比而不是与包围盒成正比。
+ *
+ * 每个块可以独立处理（ParallelForChunks），处理前用 ExchangeHalos 从相邻块复制边缘单元格到光晕，
+ * 缺失的相邻块按海洋（不存在的地形）处理，世界之外按网格光晕处理。
+ * 与模拟使用的平铺网格通过 FromGrid/ToGrid 互相转换。
+ */
+class ECHOALCHEMIST_API FWorldMorphingChunkedGrid
+{
+public:
+	/**
+	 * 设置世界尺寸并释放所有块
+	 */
+	void Init(int32 InWidth, int32 InHeight);
+
+	/** 释放所有块 */
+	void Empty();
+
+	/**
+	 * 从平铺网格构建（只为包含地形的块分配内存）
+	 */
+	void FromGrid(const FWorldMorphingGrid& Grid);
+
+	/**
+	 * 写出到平铺网格（未分配的块按默认值填充）
+	 */
+	void ToGrid(FWorldMorphingGrid& OutGrid) const;
+
+	/**
+	 * 用相邻块的边缘单元格刷新所有已分配块的光晕
+	 */
+	void ExchangeHalos();
+
+	/**
+	 * 并行处理所有已分配的块
+	 */
+	void ParallelForChunks(TFunctionRef<void(FWorldMorphingChunk& Chunk)> Body);
+
+	/** 查找块（未分配时返回 nullptr） */
+	FWorldMorphingChunk* FindChunk(int32 ChunkX, int32 ChunkY);
+	const FWorldMorphingChunk* FindChunk(int32 ChunkX, int32 ChunkY) const;
+
+	/** 查找块，未分配时分配并填充默认值 */
+	FWorldMorphingChunk& FindOrAddChunk(int32 ChunkX, int32 ChunkY);
+
+	/** 获取单元格状态（未分配的块返回默认状态） */
+	FCellState GetCellState(int32 X, int32 Y) const;
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+	int32 GetChunksX() const { return ChunksX; }
+	int32 GetChunksY() const { return ChunksY; }
+
+	/** 已分配的块数量 */
+	int32 GetNumAllocatedChunks() const;
+
+private:
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 ChunksX = 0;
+	int32 ChunksY = 0;
+
+	// 按块坐标行主序，未分配为空
+	TArray<TUniquePtr<FWorldMorphingChunk>> Chunks;
+
+	/** 世界坐标是否在网格内 */
+	bool IsInWorld(int32 X, int32 Y) const { return X >= 0 && X < Width && Y >= 0 && Y < Height; }
+};
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 到边缘距离场
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+
+/**
+ * 到地形边缘的距离场（8邻域，棋盘距离）
+ *
+ * 边缘单元格（任一邻居不存在，光晕也算）距离为0，向内逐圈加1，超过上限的单元格按上限处理。
+ * 内部存储每个单元格到最近“不存在”单元格的棋盘距离（不存在的单元格为0），
+ * 用两遍倒角扫描计算：正向扫描读取左、左上、上、右上，反向扫描读取右、右下、下、左下。
+ *
+ * 某个单元格的存在状态改变后，只有与它棋盘距离小于上限的单元格会受影响，
+ * Repair 只在这个窗口内重新扫描（窗口外的值作为边界条件），开销与变化量成正比。
+ */
+class ECHOALCHEMIST_API FWorldMorphingDistanceField
+{
+public:
+	/**
+	 * 按网格当前的存在状态完整重建
+	 * @param Grid 网格
+	 * @param InMaxDistance 需要精确求出的最大距离
+	 */
+	void Rebuild(const FWorldMorphingGrid& Grid, int32 InMaxDistance);
+
+	/**
+	 * 某个单元格的存在状态改变后，修复其周围的距离
+	 * @param Grid 已经应用改变的网格
+	 * @param Index 状态改变的单元格下标
+	 */
+	void Repair(const FWorldMorphingGrid& Grid, int32 Index);
+
+	/** 清空距离场（下次使用前需要重建） */
+	void Reset();
+
+	/** 是否已按给定网格和上限构建 */
+	bool IsBuiltFor(const FWorldMorphingGrid& Grid, int32 InMaxDistance) const
+	{
+		return MaxDistance == InMaxDistance && Depth.Num() == Grid.Num() && Pitch == Grid.Pitch;
+	}
+
+	/**
+	 * 获取存在的单元格到边缘的距离（超过上限时返回上限）
+	 * @param Index 单元格下标（调用方保证单元格存在）
+	 */
+	int32 GetDistance(int32 Index) const { return Depth[Index] - 1; }
+
+private:
+	// 到最近不存在单元格的棋盘距离，截断到 MaxDistance + 1
+	TArray<int32> Depth;
+
+	int32 MaxDistance = INDEX_NONE;
+	int32 Pitch = 0;
+
+	/** 在内部坐标矩形 [X0, X1] x [Y0, Y1] 内重新扫描 */
+	void Sweep(const FWorldMorphingGrid& Grid, int32 X0, int32 Y0, int32 X1, int32 Y1);
+};
@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 网格数据布局
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingTypes.h"
+
+/**
+ * 单元格标志位
+ */
+enum class EWorldCellFlags : uint8
+{
+	None         = 0,
+	Valid        = 1 << 0,   // 网格内部单元格（光晕单元格不设置）
+	Exists       = 1 << 1,   // 地形存在
+	Thunderstorm = 1 << 2,   // 雷暴
+	Absorbing    = 1 << 3,   // 正在吸收地幔能量
+};
+ENUM_CLASS_FLAGS(EWorldCellFlags);
+
+/**
+ * 网格的浮点字段（用于按字段访问平面）
+ */
+enum class EWorldMorphingField : uint8
+{
+	MantleEnergy,
+	Temperature,
+	TemperatureChange,
+	CrystalEnergy,
+	StoredEnergy,
+	Prosperity,
+	Count
+};
+
+/**
+ * 世界网格（结构数组布局）
+ *
+ * 每个字段一个连续数组，行主序存储，四周各有一圈光晕单元格：
+ * - 行跨度 Pitch = Width + 2，总行数 Height + 2
+ * - 网格坐标 (X, Y) 对应下标 (Y + 1) * Pitch + (X + 1)
+ * - 光晕单元格永远不存在、没有晶石，8邻域访问不会越界
+ *
+ * 各层更新只访问自己需要的字段平面，不再为每个单元格分配堆内存。
+ *
+ * 邻域访问使用固定的8个下标偏移（模板），光晕保证内部单元格的邻居下标总是合法，
+ * 内层循环不需要边界检查；邻居计数和筛选用8位掩码就地完成（第 i 位对应第 i 个偏移）。
+ */
+struct FWorldMorphingGrid
+{
+	// 网格尺寸（不含光晕）
+	int32 Width = 0;
+	int32 Height = 0;
+
+	// 行跨度（含光晕）
+	int32 Pitch = 0;
+
+	// 8邻域下标偏移（顺序: DY = -1..1, DX = -1..1，跳过自身）
+	int32 NeighborOffsets[8] = {};
+
+	// 8邻域坐标偏移（与 NeighborOffsets 一一对应）
+	static constexpr int32 NeighborDX[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+	static constexpr int32 NeighborDY[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+
+	// ========== 字段平面 ==========
+
+	// 标志位（存在、雷暴、吸收）
+	TArray<EWorldCellFlags> Flags;
+
+	// 晶石状态
+	TArray<ECrystalType> CrystalState;
+
+	// 地幔层
+	TArray<float> MantleEnergy;
+
+	// 气候层
+	TArray<float> Temperature;
+	TArray<float> TemperatureChange;
+
+	// 晶石层
+	TArray<float> CrystalEnergy;
+	TArray<float> StoredEnergy;
+
+	// 人类层
+	TArray<float> Prosperity;
+
+	/**
+	 * 分配网格并重置所有字段
+	 * @param InWidth 网格宽度
+	 * @param InHeight 网格高度
+	 */
+	void Init(int32 InWidth, int32 InHeight);
+
+	/** 释放所有字段平面 */
+	void Empty();
+
+	/** 单元格总数（含光晕） */
+	FORCEINLINE int32 Num() const { return Flags.Num(); }
+
+	/** 网格坐标转换为平面下标 */
+	FORCEINLINE int32 ToIndex(int32 X, int32 Y) const { return (Y + 1) * Pitch + (X + 1); }
+
+	/** 平面下标转换为网格X坐标 */
+	FORCEINLINE int32 GetX(int32 Index) const { return Index % Pitch - 1; }
+
+	/** 平面下标转换为网格Y坐标 */
+	FORCEINLINE int32 GetY(int32 Index) const { return Index / Pitch - 1; }
+
+	/** 是否为网格内部单元格 */
+	FORCEINLINE bool IsValid(int32 Index) const { return EnumHasAnyFlags(Flags[Index], EWorldCellFlags::Valid); }
+
+	/** 地形是否存在 */
+	FORCEINLINE bool Exists(int32 Index) const { return EnumHasAnyFlags(Flags[Index], EWorldCellFlags::Exists); }
+
+	/** 是否设置了指定标志 */
+	FORCEINLINE bool HasFlag(int32 Index, EWorldCellFlags Flag) const { return EnumHasAnyFlags(Flags[Index], Flag); }
+
+	/** 设置或清除指定标志 */
+	FORCEINLINE void SetFlag(int32 Index, EWorldCellFlags Flag, bool bValue)
+	{
+		if (bValue)
+		{
+			Flags[Index] |= Flag;
+		}
+		else
+		{
+			Flags[Index] &= ~Flag;
+		}
+	}
+
+	// ========== 模板邻域 ==========
+
+	/**
+	 * 计算设置了指定标志的邻居掩码（只能对内部单元格调用）
+	 * @param Index 平面下标
+	 * @param Flag 标志
+	 * @return 8位邻居掩码
+	 */
+	FORCEINLINE uint8 GetNeighborMask(int32 Index, EWorldCellFlags Flag) const
+	{
+		const EWorldCellFlags* Cell = Flags.GetData() + Index;
+		uint8 Mask = 0;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			Mask |= static_cast<uint8>(EnumHasAnyFlags(Cell[NeighborOffsets[i]], Flag)) << i;
+		}
+		return Mask;
+	}
+
+	/**
+	 * 计算指定晶石类型的邻居掩码（只能对内部单元格调用，不检查地形是否存在）
+	 * @param Index 平面下标
+	 * @param Type 晶石类型
+	 * @return 8位邻居掩码
+	 */
+	FORCEINLINE uint8 GetCrystalNeighborMask(int32 Index, ECrystalType Type) const
+	{
+		const ECrystalType* Cell = CrystalState.GetData() + Index;
+		uint8 Mask = 0;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			Mask |= static_cast<uint8>(Cell[NeighborOffsets[i]] == Type) << i;
+		}
+		return Mask;
+	}
+
+	/** 掩码中的邻居数量 */
+	static FORCEINLINE int32 CountNeighbors(uint8 Mask) { return FMath::CountBits(Mask); }
+
+	/**
+	 * 取掩码中第 N 个邻居（按偏移顺序）
+	 * @param Mask 邻居掩码
+	 * @param N 序号（0 ~ CountNeighbors(Mask) - 1）
+	 * @return 邻居槽位（NeighborOffsets 的下标）
+	 */
+	static FORCEINLINE int32 GetNthNeighbor(uint8 Mask, int32 N)
+	{
+		uint32 Bits = Mask;
+		for (int32 i = 0; i < N; ++i)
+		{
+			Bits &= Bits - 1;
+		}
+		return static_cast<int32>(FMath::CountTrailingZeros(Bits));
+	}
+
+	/** 按字段获取浮点平面 */
+	const TArray<float>& GetField(EWorldMorphingField Field) const
+	{
+		switch (Field)
+		{
+		case EWorldMorphingField::Temperature:       return Temperature;
+		case EWorldMorphingField::TemperatureChange: return TemperatureChange;
+		case EWorldMorphingField::CrystalEnergy:     return CrystalEnergy;
+		case EWorldMorphingField::StoredEnergy:      return StoredEnergy;
+		case EWorldMorphingField::Prosperity:        return Prosperity;
+		default:                                     return MantleEnergy;
+		}
+	}
+
+	TArray<float>& GetField(EWorldMorphingField Field)
+	{
+		return const_cast<TArray<float>&>(static_cast<const FWorldMorphingGrid*>(this)->GetField(Field));
+	}
+
+	/**
+	 * 转换为蓝图可读的状态
+	 * @param Index 平面下标
+	 * @return 单元格状态
+	 */
+	FCellState GetCellState(int32 Index) const;
+
+	/**
+	 * 计算所有字段平面的哈希（CRC32，含光晕）
+	 * 用于校验规则等价（浮点按位参与计算）：哈希不同说明网格一定不同；哈希相同说明网格极大概率逐位一致
+	 */
+	uint32 ComputeHash() const;
+};
@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 热力图纹理
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "WorldMorphing/WorldMorphingTypes.h"
+#include "WorldMorphingHeatmapTexture.generated.h"
+
+class UTexture2D;
+class UWorldMorphingSubsystem;
+struct FWorldMorphingGrid;
+
+/**
+ * 热力图纹理的像素格式
+ */
+UENUM(BlueprintType)
+enum class EWorldMorphingHeatmapFormat : uint8
+{
+	G8      UMETA(DisplayName = "8-bit"),        // 单通道8位（0-1 量化为 0-255）
+	R16F    UMETA(DisplayName = "Half Float")     // 单通道半精度
+};
+
+/**
+ * 世界变迁热力图纹理
+ *
+ * 持有一张复用的瞬态纹理（每个单元格一个像素）和一份CPU端的像素副本。
+ * 更新时直接从字段平面归一化、量化写入副本，不经过蓝图数组；
+ * 只把像素实际变化的包围矩形提交给渲染线程（UpdateTextureRegions），地图视图每帧的上传量与变化区域成正比。
+ */
+UCLASS(BlueprintType)
+class ECHOALCHEMIST_API UWorldMorphingHeatmapTexture : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * 创建热力图纹理
+	 * @param Width 宽度（单元格）
+	 * @param Height 高度（单元格）
+	 * @param Format 像素格式
+	 * @return 热力图纹理
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Visualization")
+	static UWorldMorphingHeatmapTexture* CreateHeatmapTexture(int32 Width, int32 Height, EWorldMorphingHeatmapFormat Format = EWorldMorphingHeatmapFormat::G8);
+
+	/**
+	 * 用子系统的当前世界更新整张纹理（尺寸变化时重新分配纹理）
+	 * @param Subsystem 世界变迁子系统
+	 * @param DataType 数据类型
+	 * @param Lod 细节层级（纹理尺寸跟随该层级，见 UWorldMorphingSubsystem::GetLodGrid）
+	 * @return 是否有像素被上传
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Visualization")
+	bool UpdateFromSubsystem(UWorldMorphingSubsystem* Subsystem, EHeatmapDataType DataType, int32 Lod = 0);
+
+	/**
+	 * 只更新一个区域
+	 * @param Subsystem 世界变迁子系统
+	 * @param DataType 数据类型
+	 * @param StartX 起始X坐标（该层级的单元格）
+	 * @param StartY 起始Y坐标（该层级的单元格）
+	 * @param RegionWidth 区域宽度
+	 * @param RegionHeight 区域高度
+	 * @param Lod 细节层级（与 UpdateFromSubsystem 相同）
+	 * @return 是否有像素被上传
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Visualization")
+	bool UpdateRegionFromSubsystem(UWorldMorphingSubsystem* Subsystem, EHeatmapDataType DataType,
+	                               int32 StartX, int32 StartY, int32 RegionWidth, int32 RegionHeight, int32 Lod = 0);
+
+	/**
+	 * 用网格更新若干区域（原生接口）
+	 * Activity 数据类型请使用 UpdateFromSubsystem
+	 * @param Grid 网格（尺寸必须与纹理一致）
+	 * @param DataType 数据类型
+	 * @param DirtyRects 需要刷新的区域（单元格坐标，Max 不含）
+	 * @return 是否有像素被上传
+	 */
+	bool UpdateRegions(const FWorldMorphingGrid& Grid, EHeatmapDataType DataType, TConstArrayView<FIntRect> DirtyRects);
+
+	/** 获取纹理 */
+	UFUNCTION(BlueprintPure, Category = "WorldMorphing|Visualization")
+	UTexture2D* GetTexture() const { return Texture; }
+
+	/** 获取CPU端像素副本（行主序，每像素 GetBytesPerPixel 字节） */
+	TConstArrayView<uint8> GetPixels() const { return Pixels; }
+
+	/** 每像素字节数 */
+	int32 GetBytesPerPixel() const { return Format == EWorldMorphingHeatmapFormat::G8 ? 1 : 2; }
+
+private:
+	UPROPERTY(Transient)
+	UTexture2D* Texture = nullptr;
+
+	EWorldMorphingHeatmapFormat Format = EWorldMorphingHeatmapFormat::G8;
+	int32 Width = 0;
+	int32 Height = 0;
+
+	// 上一次上传的像素
+	TArray<uint8> Pixels;
+
+	/** 按尺寸（重新）分配纹理和像素副本 */
+	void Allocate(int32 InWidth, int32 InHeight);
+
+	/**
+	 * 把一段归一化值量化写入像素副本，并扩展变化的包围矩形
+	 * @param Values 归一化值
+	 * @param X 起始列
+	 * @param Y 行
+	 * @param Count 数量
+	 * @param InOutChanged 变化区域（空矩形表示尚无变化）
+	 */
+	void StoreRow(const float* Values, int32 X, int32 Y, int32 Count, FIntRect& InOutChanged);
+
+	/** 把像素副本中的一个矩形提交给渲染线程 */
+	void UploadRect(const FIntRect& Rect);
+};
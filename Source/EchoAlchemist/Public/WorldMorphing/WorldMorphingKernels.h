@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 扩散模板内核
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+
+/**
+ * 扩散模板内核
+ *
+ * 每个内核处理同一行内连续的 Count 个内部单元格（Begin 为第一个单元格的平面下标），
+ * 按4路SIMD执行，不足4个的行尾交给对应的标量版本。
+ * 邻居是否存在由浮点存在掩码（1 或 0）相乘/选择给出，内层循环没有分支，限幅也在寄存器内完成。
+ *
+ * 标量版本与子系统原有的逐单元格规则一致，作为行尾处理和测试基准。
+ */
+namespace WorldMorphingKernels
+{
+	/**
+	 * 地幔能量交换参数
+	 */
+	struct FMantleExchangeParams
+	{
+		// 各邻居方向的迁徙偏置流量
+		float BiasFlow[8];
+
+		// 扩散系数
+		float DiffusionCoeff = 0.2f;
+	};
+
+	/**
+	 * 温度扩散参数
+	 */
+	struct FTemperatureParams
+	{
+		// 扩散速率
+		float DiffusionRate = 0.12f;
+
+		// 季节性偏移
+		float SeasonalOffset = 0.0f;
+	};
+
+	/**
+	 * 把存在标志转换为浮点掩码（存在为1，否则为0）
+	 */
+	ECHOALCHEMIST_API void BuildExistsMask(const EWorldCellFlags* Flags, float* OutMask, int32 Begin, int32 Count);
+
+	/**
+	 * 地幔能量交换（9点模板）
+	 * 存在的单元格: E' = Clamp(E + 2 * Σ 存在邻居 Clamp((En - E) * k + Bias, -2, 2), 0, 150)，不存在的保持不变
+	 */
+	ECHOALCHEMIST_API void MantleExchange(const int32* Offsets, const float* ExistsMask, const float* Energy, float* OutEnergy,
+		const FMantleExchangeParams& Params, int32 Begin, int32 Count);
+	ECHOALCHEMIST_API void MantleExchangeScalar(const int32* Offsets, const float* ExistsMask, const float* Energy, float* OutEnergy,
+		const FMantleExchangeParams& Params, int32 Begin, int32 Count);
+
+	/**
+	 * 温度扩散（9点模板，向存在邻居的平均值松弛）
+	 * 同时更新存在单元格的温度变化量；不存在的单元格温度为 -50
+	 */
+	ECHOALCHEMIST_API void DiffuseTemperature(const int32* Offsets, const float* ExistsMask, const float* MantleEnergy, const ECrystalType* CrystalState,
+		const float* Temperature, float* TemperatureChange, float* OutTemperature, const FTemperatureParams& Params, int32 Begin, int32 Count);
+	ECHOALCHEMIST_API void DiffuseTemperatureScalar(const int32* Offsets, const float* ExistsMask, const float* MantleEnergy, const ECrystalType* CrystalState,
+		const float* Temperature, float* TemperatureChange, float* OutTemperature, const FTemperatureParams& Params, int32 Begin, int32 Count);
+
+	/**
+	 * 雷暴判定：存在的单元格与存在邻居的最大温差超过阈值时设置雷暴标志
+	 */
+	ECHOALCHEMIST_API void UpdateThunderstorms(const int32* Offsets, const float* ExistsMask, const float* Temperature,
+		const EWorldCellFlags* Flags, EWorldCellFlags* OutFlags, float Threshold, int32 Begin, int32 Count);
+	ECHOALCHEMIST_API void UpdateThunderstormsScalar(const int32* Offsets, const float* ExistsMask, const float* Temperature,
+		const EWorldCellFlags* Flags, EWorldCellFlags* OutFlags, float Threshold, int32 Begin, int32 Count);
+}
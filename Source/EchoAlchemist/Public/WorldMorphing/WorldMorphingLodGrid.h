@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 降采样细节层级
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+#include "WorldMorphing/WorldMorphingActivityMap.h"
+
+/**
+ * 降采样细节层级（LOD）
+ *
+ * 层级 L 的每个单元格聚合全分辨率网格中 2^L x 2^L 的块（LOD 1 = 2x，LOD 2 = 4x），
+ * 每个层级本身也是一个 FWorldMorphingGrid，现有的读取路径（单元格状态、热力图、热力图纹理）可以直接使用：
+ * - 浮点字段取块内地形单元格的平均值，繁荣度取最大值
+ * - 晶石状态取块内地形单元格的多数（并列时取非空的类型）
+ * - 地形存在: 至少一半的单元格存在；雷暴、吸收: 至少一半的地形单元格设置
+ *
+ * 按 TileSize 分块增量更新：聚合只读取地形单元格，上次更新和这次都没有地形的块结果不变，直接跳过；
+ * 其他块每次更新都重新聚合。尺寸或世界变化后调用 MarkAllDirty 强制全部重建。
+ */
+class ECHOALCHEMIST_API FWorldMorphingLodGrid
+{
+public:
+	// 层级数量（不含全分辨率的 LOD 0）
+	static constexpr int32 NumLevels = 2;
+
+	// 增量更新的块边长（全分辨率单元格，必须是最粗层级块边长的倍数）
+	static constexpr int32 TileSize = FWorldMorphingActivityMap::TileSize;
+	static_assert(TileSize % (1 << NumLevels) == 0, "LOD blocks must not straddle tiles");
+
+	/**
+	 * 按全分辨率尺寸分配所有层级，所有块标记为脏
+	 */
+	void Init(int32 InWidth, int32 InHeight);
+
+	/** 释放 */
+	void Reset();
+
+	/** 下一次更新时重建所有块 */
+	void MarkAllDirty();
+
+	/**
+	 * 用全分辨率网格更新所有层级
+	 * @param Grid 网格（尺寸必须与 Init 一致）
+	 * @return 重新聚合的块数
+	 */
+	int32 Update(const FWorldMorphingGrid& Grid);
+
+	/**
+	 * 获取层级网格
+	 * @param Lod 层级（1 ~ NumLevels）
+	 */
+	const FWorldMorphingGrid& GetLevel(int32 Lod) const { return Levels[Lod - 1]; }
+
+	/** 层级的降采样倍数 */
+	static int32 GetFactor(int32 Lod) { return 1 << Lod; }
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+private:
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 TilesX = 0;
+	int32 TilesY = 0;
+
+	FWorldMorphingGrid Levels[NumLevels];
+
+	// 上次更新时包含地形的块
+	TArray<uint8> TileHadLand;
+
+	// 强制重建的块
+	TArray<uint8> TileDirty;
+
+	/** 块内是否有地形单元格 */
+	bool TileHasLand(const FWorldMorphingGrid& Grid, int32 TileX, int32 TileY) const;
+
+	/**
+	 * 聚合一个降采样单元格
+	 * @param Grid 全分辨率网格
+	 * @param Factor 降采样倍数
+	 * @param LodX 层级X坐标
+	 * @param LodY 层级Y坐标
+	 * @param OutLevel 层级网格
+	 */
+	static void ReduceBlock(const FWorldMorphingGrid& Grid, int32 Factor, int32 LodX, int32 LodY, FWorldMorphingGrid& OutLevel);
+};
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 计数器随机数
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 计数器随机数（SplitMix64 风格）
+ *
+ * 每个随机数是 (种子, 时间步, 阶段, 键, 抽取序号) 的哈希，没有需要推进的共享状态：
+ * 同一单元格在同一步同一阶段的决定只取决于这几个值，与遍历顺序、条带划分、跳过了哪些块和线程数无关。
+ * 用法：每个单元格（或供给点）在每个阶段构造一个实例，按固定顺序抽取。
+ */
+struct FWorldMorphingCellRandom
+{
+	/**
+	 * @param Seed 世界种子
+	 * @param TimeStep 时间步
+	 * @param Stage 阶段编号（同一步内不同阶段的序列互不相关）
+	 * @param Key 单元格平面下标（或供给点序号）
+	 */
+	FWorldMorphingCellRandom(int32 Seed, int32 TimeStep, int32 Stage, int32 Key)
+	{
+		uint64 Hash = Mix(static_cast<uint64>(static_cast<uint32>(Seed)) << 32 | static_cast<uint32>(TimeStep));
+		Hash = Mix(Hash ^ (static_cast<uint64>(static_cast<uint32>(Stage)) << 32 | static_cast<uint32>(Key)));
+		Counter = Hash;
+	}
+
+	/** 下一个64位随机数 */
+	FORCEINLINE uint64 Next()
+	{
+		Counter += 0x9E3779B97F4A7C15ull;
+		return Mix(Counter);
+	}
+
+	/** [0, 1) 的浮点随机数 */
+	FORCEINLINE float FRand()
+	{
+		// 取高24位，保证结果严格小于1
+		return static_cast<float>(Next() >> 40) * (1.0f / 16777216.0f);
+	}
+
+	/** [Min, Max] 的整数随机数 */
+	FORCEINLINE int32 RandRange(int32 Min, int32 Max)
+	{
+		const uint32 Range = static_cast<uint32>(Max - Min) + 1;
+		return Min + static_cast<int32>((static_cast<uint64>(static_cast<uint32>(Next() >> 32)) * Range) >> 32);
+	}
+
+	/** SplitMix64 终结函数 */
+	static FORCEINLINE uint64 Mix(uint64 Value)
+	{
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+		return Value ^ (Value >> 31);
+	}
+
+private:
+	uint64 Counter = 0;
+};
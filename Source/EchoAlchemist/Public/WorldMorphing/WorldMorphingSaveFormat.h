@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 二进制存档格式
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+#include "WorldMorphing/WorldMorphingSupplyDensity.h"
+
+/**
+ * 存档头（世界尺寸和串行模拟状态）
+ */
+struct FWorldMorphingSaveHeader
+{
+	int32 Width = 0;
+	int32 Height = 0;
+
+	// 是否为相对关键帧的增量存档
+	bool bDelta = false;
+
+	// 模拟状态
+	int32 TimeStep = 0;
+	int32 CycleCount = 0;
+	int32 Seed = 0;
+
+	// 串行随机流的当前状态（FRandomStream::GetCurrentSeed）
+	int32 RandomState = 0;
+
+	// 噪声偏移
+	float NoiseOffsetX = 0.0f;
+	float NoiseOffsetY = 0.0f;
+
+	// 边缘供给点
+	TArray<FEdgeSupplyPoint> EdgeSupplyPoints;
+};
+
+/**
+ * 世界存档的二进制格式
+ *
+ * 网格内部单元格量化为逐字段的平面：标志和晶石状态各1字节，能量/温度等浮点字段为半精度，
+ * 半精度的低字节和高字节分成两个平面（高字节变化很少，压缩率更高）。
+ * 增量存档把平面与关键帧的平面逐字节异或，未变化的单元格全部为0；
+ * 整个平面块再用 Oodle 压缩。存档头记录关键帧平面的校验和，加载增量时必须提供同一个关键帧。
+ *
+ * 量化是幂等的（加载后再量化得到相同的平面），因此关键帧既可以在保存时生成，也可以在加载后生成。
+ */
+class ECHOALCHEMIST_API FWorldMorphingSaveFormat
+{
+public:
+	// 文件标识 "EAWM"
+	static constexpr uint32 Magic = 0x4D574145;
+
+	// 格式版本
+	static constexpr int32 Version = 1;
+
+	// 每个单元格的平面字节数（2个字节字段 + 6个半精度字段）
+	static constexpr int32 BytesPerCell = 2 + 6 * 2;
+
+	/**
+	 * 量化平面的字节数（按64位计算）
+	 * @return 尺寸非正或字节数超过 int32 范围时返回 INDEX_NONE
+	 */
+	static int32 GetPlaneSize(int32 Width, int32 Height);
+
+	/**
+	 * 把网格内部单元格量化为平面
+	 * @param Grid 网格
+	 * @param OutPlanes 输出平面（Width * Height * BytesPerCell 字节）
+	 * @return 网格过大（平面字节数超过 int32 范围）时返回 false
+	 */
+	static bool QuantizePlanes(const FWorldMorphingGrid& Grid, TArray<uint8>& OutPlanes);
+
+	/**
+	 * 把平面还原为网格（光晕按默认值初始化）
+	 * @return 平面大小与尺寸不符时返回 false
+	 */
+	static bool DequantizePlanes(TConstArrayView<uint8> Planes, int32 Width, int32 Height, FWorldMorphingGrid& OutGrid);
+
+	/**
+	 * 写出存档
+	 * @param Header 存档头（bDelta 由 KeyframePlanes 是否为空决定）
+	 * @param Planes 量化平面
+	 * @param KeyframePlanes 关键帧平面（为空时写出完整存档）
+	 * @param OutData 输出数据
+	 */
+	static void Save(const FWorldMorphingSaveHeader& Header, TConstArrayView<uint8> Planes, TConstArrayView<uint8> KeyframePlanes, TArray<uint8>& OutData);
+
+	/**
+	 * 读取存档
+	 * @param Data 存档数据
+	 * @param KeyframePlanes 关键帧平面（只在增量存档时使用）
+	 * @param OutHeader 存档头
+	 * @param OutPlanes 还原后的完整平面
+	 * @return 数据损坏、版本不符或关键帧不匹配时返回 false
+	 */
+	static bool Load(TConstArrayView<uint8> Data, TConstArrayView<uint8> KeyframePlanes, FWorldMorphingSaveHeader& OutHeader, TArray<uint8>& OutPlanes);
+
+private:
+	/** 异或到关键帧（增量编码和解码是同一个操作） */
+	static void XorPlanes(TArrayView<uint8> Planes, TConstArrayView<uint8> KeyframePlanes);
+};
@@ -0,0 +1,218 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 模拟引擎
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingTypes.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+#include "WorldMorphing/WorldMorphingDistanceField.h"
+#include "WorldMorphing/WorldMorphingSupplyDensity.h"
+#include "WorldMorphing/WorldMorphingActivityMap.h"
+#include "WorldMorphing/WorldMorphingStatistics.h"
+#include "WorldMorphing/WorldMorphingRandom.h"
+
+class FWorldMorphingChunkedGrid;
+struct FWorldMorphingSaveHeader;
+
+/**
+ * 各层更新的累计耗时（自上次重置以来）
+ */
+struct FWorldMorphingLayerTimings
+{
+	double MantleSeconds = 0.0;
+	double ClimateSeconds = 0.0;
+	double CrystalSeconds = 0.0;
+	double HumanSeconds = 0.0;
+
+	// 累计的步数
+	int32 Steps = 0;
+
+	double GetTotalSeconds() const { return MantleSeconds + ClimateSeconds + CrystalSeconds + HumanSeconds; }
+};
+
+/**
+ * 世界变迁模拟引擎
+ *
+ * 持有一个世界的全部模拟状态（网格、参数、随机流、供给点和各种派生缓存），不依赖 UObject 和游戏实例。
+ * UWorldMorphingSubsystem 包装一个实例并在其上提供异步模式、快照和蓝图接口；
+ * 批量实验（见 UWorldMorphingSweepCommandlet）直接创建多个实例，在不同核心上各自推进。
+ * 单个实例不是线程安全的，同一时间只能由一个线程推进或读取。
+ */
+class ECHOALCHEMIST_API FWorldMorphingSim
+{
+public:
+	/**
+	 * 初始化世界
+	 * @param InWidth 网格宽度
+	 * @param InHeight 网格高度
+	 * @param InitParams 初始参数（RandomSeed 为0时随机选取种子）
+	 */
+	void Initialize(int32 InWidth, int32 InHeight, const FSimulationParams& InitParams);
+
+	/** 释放所有状态（回到未初始化） */
+	void Empty();
+
+	/** 推进一步模拟 */
+	void Step();
+
+	/** 是否已初始化 */
+	bool IsInitialized() const { return Width > 0 && Height > 0; }
+
+	/**
+	 * 从存档恢复（参数保持不变）
+	 * @param Header 存档头
+	 * @param InGrid 存档网格（尺寸与存档头一致）
+	 */
+	void RestoreState(const FWorldMorphingSaveHeader& Header, FWorldMorphingGrid&& InGrid);
+
+	/**
+	 * 从分块布局导入网格状态（尺寸可以不同；参数、种子和时间步保持不变）
+	 * @param Chunks 分块网格
+	 */
+	void ImportChunks(const FWorldMorphingChunkedGrid& Chunks);
+
+	/** 汇总各层的块级活跃度（位0: 晶石层处理，位1: 人类层处理） */
+	void BuildActivityTiles(TArray<uint8>& OutTiles) const;
+
+	// ========== 状态访问 ==========
+
+	const FWorldMorphingGrid& GetGrid() const { return Grid; }
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+	const FSimulationParams& GetParams() const { return Params; }
+	void SetParams(const FSimulationParams& NewParams) { Params = NewParams; }
+
+	int32 GetTimeStep() const { return TimeStep; }
+	int32 GetCycleCount() const { return CycleCount; }
+	int32 GetSeed() const { return Seed; }
+
+	/** 串行随机流的当前状态（存档用） */
+	int32 GetRandomState() const { return RandomStream.GetCurrentSeed(); }
+
+	float GetNoiseOffsetX() const { return NoiseOffsetX; }
+	float GetNoiseOffsetY() const { return NoiseOffsetY; }
+	const TArray<FEdgeSupplyPoint>& GetEdgeSupplyPoints() const { return EdgeSupplyPoints; }
+
+	/** 获取世界统计（增量维护，O(1)） */
+	FWorldStatistics GetStatistics() const { return Statistics.ToStatistics(); }
+
+	/** 各层更新的累计耗时（基准测试用） */
+	const FWorldMorphingLayerTimings& GetLayerTimings() const { return LayerTimings; }
+	void ResetLayerTimings() { LayerTimings = FWorldMorphingLayerTimings(); }
+
+	/**
+	 * 设置是否在条带之间多线程（相同种子下结果与是否多线程无关）
+	 * 同时推进多个世界时关闭，让并行发生在世界之间
+	 */
+	void SetUseMultithreading(bool bEnable) { bUseMultithreading = bEnable; }
+	bool IsUsingMultithreading() const { return bUseMultithreading; }
+
+private:
+	// 网格数据（结构数组布局，含光晕）
+	FWorldMorphingGrid Grid;
+	int32 Width = 0;
+	int32 Height = 0;
+
+	// 后台缓冲：并行阶段读取 Grid、写入 BackGrid，然后交换对应的字段平面
+	FWorldMorphingGrid BackGrid;
+
+	// 浮点存在掩码（1 = 存在），供SIMD扩散内核使用，光晕为0
+	TArray<float> ExistsMask;
+
+	// 每个并行条带的行数（固定值，保证条带划分和按条带顺序合并的结果与线程数无关）
+	static constexpr int32 RowsPerBand = 16;
+	static_assert(RowsPerBand == FWorldMorphingActivityMap::TileSize, "One row of activity tiles must be one band");
+
+	// 增量统计每隔多少步全量重新计算一次
+	static constexpr int32 StatisticsRecomputeInterval = 256;
+
+	// 是否使用多线程更新
+	bool bUseMultithreading = true;
+
+	// 模拟状态
+	int32 TimeStep = 0;
+	int32 CycleCount = 0;
+	FSimulationParams Params;
+
+	// 随机种子和串行阶段（世界初始化、人类初始聚落）使用的随机流；逐单元格的决定使用计数器随机数
+	int32 Seed = 0;
+	FRandomStream RandomStream;
+
+	// 噪声偏移(用于域扭曲)
+	float NoiseOffsetX = 0.0f;
+	float NoiseOffsetY = 0.0f;
+
+	// 边缘供给点
+	TArray<FEdgeSupplyPoint> EdgeSupplyPoints;
+
+	// 供给点的角度密度表（每步重建）
+	FWorldMorphingSupplyDensity SupplyDensity;
+
+	// 每个单元格相对世界中心的角度 [0, 2π) 和距离（初始化时构建，尺寸不变则不变）
+	TArray<float> CellAngles;
+	TArray<float> CellRadii;
+
+	// 径向掩码（每个单元格是否在 MaxRadius 之内、MinRadius 之外），构建时使用的半径改变时重建
+	TArray<uint8> RadialMask;
+	float RadialMaskMaxRadius = -1.0f;
+	float RadialMaskMinRadius = -1.0f;
+
+	// 到边缘距离场（地形变化时增量修复）
+	FWorldMorphingDistanceField EdgeDistance;
+
+	// 增量维护的世界统计
+	FWorldMorphingStatistics Statistics;
+
+	// 各层更新的累计耗时
+	FWorldMorphingLayerTimings LayerTimings;
+
+	// 稀疏层的块级活跃度（晶石层: Alpha 晶石，人类层: 聚落）
+	FWorldMorphingActivityMap CrystalActivity;
+	FWorldMorphingActivityMap HumanActivity;
+
+	// 人类层的提议平面（固定大小，见 UpdateHumanLayer；提议在处理集合之外始终为0）
+	TArray<uint32> HumanProposals;
+	TArray<float> HumanProposedProsperity;
+
+	// 人类层汇聚阶段每个单元格选中的到达者（邻居槽位 + 1，0 表示没有）
+	TArray<uint8> HumanArrivals;
+
+	// 更新各层
+	void UpdateMantleLayer();
+	void UpdateClimateLayer();
+	void UpdateCrystalLayer();
+	void UpdateHumanLayer();
+
+	// 辅助函数
+	bool IsValidCoord(int32 X, int32 Y) const;
+
+	/** 条带数量 */
+	int32 GetNumBands() const;
+
+	/**
+	 * 按固定行条带并行执行
+	 * @param Body 条带函数（条带序号、起始平面下标、结束平面下标（不含））
+	 */
+	void ParallelForBands(TFunctionRef<void(int32 Band, int32 BeginIndex, int32 EndIndex)> Body) const;
+
+	/** 根据当前存在标志重建浮点存在掩码 */
+	void RefreshExistsMask();
+
+	/** 构建单元格几何缓存（角度、到中心的距离），并使径向掩码失效 */
+	void BuildGeometryCache();
+
+	/** 按当前参数中的半径重建径向掩码（半径未变时直接返回） */
+	void RefreshRadialMask();
+
+	/** 按当前尺寸重新分配后台缓冲并重置派生状态（存在掩码、距离场、活跃度、几何缓存、统计） */
+	void ResetDerivedState();
+
+	/**
+	 * 创建单元格专用的计数器随机数（由种子、时间步、阶段和键决定，与遍历顺序无关）
+	 * @param Stage 阶段编号
+	 * @param Key 单元格平面下标（或供给点序号）
+	 */
+	FWorldMorphingCellRandom MakeCellRandom(int32 Stage, int32 Key) const;
+};
@@ -59,6 +59,16 @@ public:
 	          meta = (WorldContext = "WorldContextObject"))
 	static void SetPaused(UObject* WorldContextObject, bool bPause);
 
+	/**
+	 * 设置时间加速（快进）
+	 * @param WorldContextObject 世界上下文对象
+	 * @param StepsPerSecond 目标每秒模拟步数（<= 0 关闭）
+	 * @param FrameBudgetMs 每帧用于模拟的最长时间（毫秒）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Simulation", 
+	          meta = (WorldContext = "WorldContextObject"))
+	static void SetTimeWarp(UObject* WorldContextObject, float StepsPerSecond, float FrameBudgetMs = 8.0f);
+
 	/**
 	 * 获取模拟状态
 	 * @param WorldContextObject 世界上下文对象
@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 快照发布
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+#include "WorldMorphing/WorldMorphingSupplyDensity.h"
+#include <atomic>
+
+/**
+ * 世界快照
+ * 发布后不再修改，读取端可以安全访问
+ */
+struct FWorldMorphingSnapshot
+{
+	// 网格数据
+	FWorldMorphingGrid Grid;
+
+	// 块级活跃度（调试用，见 UWorldMorphingSubsystem::GetActivityHeatmap）
+	TArray<uint8> ActivityTiles;
+
+	// 快照对应的模拟时间步
+	int32 TimeStep = 0;
+
+	// 快照对应的周期计数
+	int32 CycleCount = 0;
+
+	// 世界统计
+	FWorldStatistics Statistics;
+
+	// 串行随机流状态和边缘供给点（存档用）
+	int32 RandomState = 0;
+	TArray<FEdgeSupplyPoint> EdgeSupplyPoints;
+
+	// 快照版本（每次发布递增，0 表示尚未发布）
+	uint64 Version = 0;
+};
+
+/**
+ * 无锁三缓冲快照
+ *
+ * 单写单读：写入端（模拟线程）填充后台缓冲后发布，读取端（游戏线程）获取最新发布的缓冲。
+ * 三个缓冲分别由写入端、读取端和中间槽位持有，发布和获取都只是一次原子交换，
+ * 双方互不等待；读取端持有的缓冲在下一次获取之前保持不变。
+ */
+class FWorldMorphingSnapshotBuffer
+{
+public:
+	FWorldMorphingSnapshotBuffer() = default;
+
+	/** 重置所有缓冲（调用时不能有写入端或读取端在访问） */
+	void Reset();
+
+	/** 写入端：获取可写的后台快照 */
+	FWorldMorphingSnapshot& GetWriteBuffer() { return Buffers[WriteIndex]; }
+
+	/** 写入端：发布后台快照（版本号自动递增） */
+	void Publish();
+
+	/**
+	 * 读取端：切换到最新发布的快照（没有新快照时保持当前快照）
+	 * @return 读取端当前持有的快照
+	 */
+	const FWorldMorphingSnapshot& AcquireLatest();
+
+	/** 读取端：当前持有的快照（不切换） */
+	const FWorldMorphingSnapshot& GetReadBuffer() const { return Buffers[ReadIndex]; }
+
+private:
+	// 中间槽位编码: 低2位为缓冲下标，FreshBit 表示尚未被读取端取走
+	static constexpr uint32 IndexMask = 0x3;
+	static constexpr uint32 FreshBit = 0x4;
+
+	FWorldMorphingSnapshot Buffers[3];
+
+	// 写入端独占
+	uint32 WriteIndex = 0;
+	uint64 NextVersion = 1;
+
+	// 读取端独占
+	uint32 ReadIndex = 1;
+
+	// 中间槽位（原子交换）
+	std::atomic<uint32> MiddleSlot{ 2 };
+};
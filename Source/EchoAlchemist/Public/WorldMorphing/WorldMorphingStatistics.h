@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 增量统计
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+
+/**
+ * 逐单元格场统计的部分和（地形、雷暴、地幔能量、温度）
+ * 各条带分别累加，再按条带顺序合并，结果与线程数无关
+ */
+struct FWorldMorphingFieldTotals
+{
+	int32 TerrainCells = 0;
+	int32 ThunderstormCells = 0;
+	double MantleEnergy = 0.0;
+	double Temperature = 0.0;
+
+	/**
+	 * 累加一段连续单元格
+	 * @param Flags 标志平面
+	 * @param InMantleEnergy 地幔能量平面
+	 * @param InTemperature 温度平面
+	 * @param Begin 起始下标
+	 * @param Count 单元格数量
+	 */
+	void Accumulate(const EWorldCellFlags* Flags, const float* InMantleEnergy, const float* InTemperature, int32 Begin, int32 Count);
+
+	FWorldMorphingFieldTotals& operator+=(const FWorldMorphingFieldTotals& Other)
+	{
+		TerrainCells += Other.TerrainCells;
+		ThunderstormCells += Other.ThunderstormCells;
+		MantleEnergy += Other.MantleEnergy;
+		Temperature += Other.Temperature;
+		return *this;
+	}
+};
+
+/**
+ * 晶石状态转移的计数变化（每种状态的增减）
+ */
+struct FWorldMorphingCrystalDeltas
+{
+	static constexpr int32 NumTypes = static_cast<int32>(ECrystalType::Human) + 1;
+
+	int32 Counts[NumTypes] = {};
+
+	FORCEINLINE void Add(ECrystalType From, ECrystalType To)
+	{
+		Counts[static_cast<int32>(From)]--;
+		Counts[static_cast<int32>(To)]++;
+	}
+};
+
+/**
+ * 增量维护的世界统计
+ *
+ * 晶石数量在状态转移发生时更新；地形、雷暴、地幔能量和温度总和由气候层在逐行更新时顺带累加
+ * （气候层之后只有晶石吸收会改变地幔能量，由晶石层补记）。
+ * 子系统每隔固定步数全量重新计算一次，修正可能的累积误差；查询为 O(1)。
+ */
+class ECHOALCHEMIST_API FWorldMorphingStatistics
+{
+public:
+	/** 全量扫描网格，重新计算所有统计 */
+	void Recompute(const FWorldMorphingGrid& Grid);
+
+	/** 清零 */
+	void Reset();
+
+	/** 记录一次晶石状态转移 */
+	FORCEINLINE void OnCrystalChanged(ECrystalType From, ECrystalType To)
+	{
+		CrystalDeltas.Add(From, To);
+	}
+
+	/** 合并条带收集的晶石计数变化 */
+	void ApplyCrystalDeltas(const FWorldMorphingCrystalDeltas& Deltas);
+
+	/** 设置场统计（气候层汇总的结果） */
+	void SetFieldTotals(const FWorldMorphingFieldTotals& Totals) { FieldTotals = Totals; }
+
+	/** 补记地幔能量总和的变化 */
+	void AddMantleEnergy(double Delta) { FieldTotals.MantleEnergy += Delta; }
+
+	/** 某种晶石状态的单元格数量 */
+	int32 GetCrystalCount(ECrystalType Type) const { return CrystalDeltas.Counts[static_cast<int32>(Type)]; }
+
+	/** 转换为蓝图可读的统计 */
+	FWorldStatistics ToStatistics() const;
+
+private:
+	int32 TotalCells = 0;
+
+	// 各晶石状态的单元格数量（复用计数变化的结构，从0开始累加即为当前数量）
+	FWorldMorphingCrystalDeltas CrystalDeltas;
+
+	FWorldMorphingFieldTotals FieldTotals;
+};
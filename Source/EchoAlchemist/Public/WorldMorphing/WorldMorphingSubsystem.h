@@ -6,24 +6,26 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "WorldMorphing/WorldMorphingTypes.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+#include "WorldMorphing/WorldMorphingSim.h"
+#include "WorldMorphing/WorldMorphingLodGrid.h"
+#include "WorldMorphing/WorldMorphingSnapshot.h"
+#include "WorldMorphing/WorldMorphingChunkedGrid.h"
+#include "WorldMorphing/WorldMorphingSaveFormat.h"
 #include "WorldMorphing/PerlinNoise.h"
 #include "WorldMorphingSubsystem.generated.h"
 
-/**
- * 边缘供给点数据
- */
-struct FEdgeSupplyPoint
-{
-	float Angle;
-	float Speed;
-
-	FEdgeSupplyPoint() : Angle(0.0f), Speed(0.0f) {}
-	FEdgeSupplyPoint(float InAngle, float InSpeed) : Angle(InAngle), Speed(InSpeed) {}
-};
+class FRunnable;
+class FRunnableThread;
 
 /**
  * 世界变迁子系统
- * 管理整个世界网格的模拟更新
+ * 管理整个世界网格的模拟更新（模拟本身由 FWorldMorphingSim 完成）
+ *
+ * 两种运行模式：
+ * - 同步模式（默认）：调用方每帧调用 TickSimulation，在调用线程上完成一步模拟
+ * - 异步模式：StartAsyncSimulation 之后由后台线程按自己的频率推进，每步结束发布一份只读快照；
+ *   GetCellAt 等读取接口读取最新发布的快照，游戏线程从不等待模拟
  */
 UCLASS()
 class ECHOALCHEMIST_API UWorldMorphingSubsystem : public UGameInstanceSubsystem
@@ -46,6 +48,7 @@ public:
 
 	/**
 	 * 更新模拟(每帧调用)
+	 * 没有时间加速时每次调用推进一步；开启时间加速后按 DeltaTime 推进多步（见 SetTimeWarp）
 	 * @param DeltaTime 时间增量
 	 */
 	UFUNCTION(BlueprintCallable, Category = "WorldMorphing")
@@ -71,7 +74,7 @@ public:
 	 * 获取当前模拟参数
 	 */
 	UFUNCTION(BlueprintPure, Category = "WorldMorphing")
-	FSimulationParams GetSimulationParams() const { return Params; }
+	FSimulationParams GetSimulationParams() const;
 
 	/**
 	 * 获取网格尺寸
@@ -79,47 +82,262 @@ public:
 	UFUNCTION(BlueprintPure, Category = "WorldMorphing")
 	void GetGridSize(int32& OutWidth, int32& OutHeight) const;
 
+	/**
+	 * 获取世界统计（模拟过程中增量维护，O(1)）
+	 */
+	UFUNCTION(BlueprintPure, Category = "WorldMorphing")
+	FWorldStatistics GetStatistics() const;
+
 	/**
 	 * 获取当前时间步
 	 */
 	UFUNCTION(BlueprintPure, Category = "WorldMorphing")
-	int32 GetTimeStep() const { return TimeStep; }
+	int32 GetTimeStep() const;
 
 	/**
 	 * 获取周期计数
 	 */
 	UFUNCTION(BlueprintPure, Category = "WorldMorphing")
-	int32 GetCycleCount() const { return CycleCount; }
+	int32 GetCycleCount() const;
 
-private:
-	// 网格数据
-	TArray<TArray<FCell>> Grid;
-	int32 Width;
-	int32 Height;
+	/**
+	 * 设置是否使用多线程更新各层（相同种子下结果与是否多线程无关）
+	 * @param bEnable 是否启用
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing")
+	void SetUseMultithreading(bool bEnable) { Sim.SetUseMultithreading(bEnable); }
+
+	/**
+	 * 获取当前随机种子
+	 */
+	UFUNCTION(BlueprintPure, Category = "WorldMorphing")
+	int32 GetRandomSeed() const { return Sim.GetSeed(); }
+
+	/**
+	 * 获取各层更新的累计耗时（自初始化或上次重置以来，只在同步模式下读取）
+	 */
+	const FWorldMorphingLayerTimings& GetLayerTimings() const { return Sim.GetLayerTimings(); }
+	void ResetLayerTimings() { Sim.ResetLayerTimings(); }
+
+	// ========== 时间加速 ==========
+
+	/**
+	 * 设置时间加速
+	 * 同步模式下 TickSimulation 每帧推进 StepsPerSecond * DeltaTime 步（小数部分累积到下一帧），
+	 * 超出帧预算时剩余步数同样留到下一帧，积压最多保留 MaxTimeWarpBacklogSeconds 秒；
+	 * 异步模式下后台线程改按该频率推进，不受帧预算限制
+	 * @param StepsPerSecond 目标每秒模拟步数（<= 0 关闭时间加速）
+	 * @param FrameBudgetMs 每帧用于模拟的最长时间（毫秒，<= 0 表示不限）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|TimeWarp")
+	void SetTimeWarp(float StepsPerSecond, float FrameBudgetMs = 8.0f);
+
+	/**
+	 * 获取时间加速的目标每秒步数（0 表示关闭）
+	 */
+	UFUNCTION(BlueprintPure, Category = "WorldMorphing|TimeWarp")
+	float GetTimeWarp() const { return TimeWarpStepsPerSecond.load(); }
+
+	/**
+	 * 获取实际达到的每秒模拟步数（同步和异步模式都统计，约每半秒刷新）
+	 */
+	UFUNCTION(BlueprintPure, Category = "WorldMorphing|TimeWarp")
+	float GetAchievedStepsPerSecond() const { return AchievedStepsPerSecond.load(); }
+
+	/**
+	 * 获取同步模式下留到下一帧的步数（含小数部分）
+	 */
+	UFUNCTION(BlueprintPure, Category = "WorldMorphing|TimeWarp")
+	float GetTimeWarpBacklog() const { return TimeWarpBacklog; }
+
+	// ========== 异步模拟 ==========
+
+	/**
+	 * 启动后台模拟（已在运行时只更新频率）
+	 * @param StepsPerSecond 每秒模拟步数（<= 0 表示不限速）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Async")
+	void StartAsyncSimulation(float StepsPerSecond = 60.0f);
+
+	/**
+	 * 停止后台模拟（等待当前一步完成后返回）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Async")
+	void StopAsyncSimulation();
+
+	/**
+	 * 后台模拟是否在运行
+	 */
+	UFUNCTION(BlueprintPure, Category = "WorldMorphing|Async")
+	bool IsAsyncSimulationRunning() const { return AsyncThread != nullptr; }
+
+	/**
+	 * 获取读取端当前快照的版本（同步模式下为0）
+	 */
+	UFUNCTION(BlueprintPure, Category = "WorldMorphing|Async")
+	int64 GetSnapshotVersion() const;
+
+	// ========== 调试 ==========
+
+	/**
+	 * 获取活跃度热力图（行主序，每个单元格: 晶石层处理该块 +0.5，人类层处理该块 +0.5）
+	 * @param Lod 细节层级（见 GetLodGrid）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Debug")
+	TArray<float> GetActivityHeatmap(int32 Lod = 0) const;
+
+	/**
+	 * 把活跃度热力图写入调用方提供的缓冲（原生接口，不分配内存，只能在游戏线程调用）
+	 * @param Lod 细节层级
+	 * @param OutHeatmap 输出缓冲（大小必须为该层级的宽 * 高）
+	 * @return 世界未初始化或缓冲大小不符时返回 false
+	 */
+	bool WriteActivityHeatmap(int32 Lod, TArrayView<float> OutHeatmap) const;
+
+	/**
+	 * 获取供读取的网格（只能在游戏线程调用）
+	 * 异步模式下切换到最新发布的快照，引用在下一次读取之前保持不变；同步模式下为当前网格
+	 */
+	const FWorldMorphingGrid& GetReadGrid() const;
+
+	/**
+	 * 获取可读网格某个浮点字段的平面（零拷贝，含光晕，下标见 FWorldMorphingGrid::ToIndex）
+	 * 视图的有效期与 GetReadGrid 的引用相同；需要多个字段来自同一快照时先取一次 GetReadGrid
+	 */
+	TConstArrayView<float> GetFieldView(EWorldMorphingField Field) const { return GetReadGrid().GetField(Field); }
+
+	/** 获取可读网格的标志平面（零拷贝，含光晕） */
+	TConstArrayView<EWorldCellFlags> GetFlagsView() const { return GetReadGrid().Flags; }
+
+	/** 获取可读网格的晶石状态平面（零拷贝，含光晕） */
+	TConstArrayView<ECrystalType> GetCrystalStateView() const { return GetReadGrid().CrystalState; }
+
+	/**
+	 * 获取降采样网格（只能在游戏线程调用，见 FWorldMorphingLodGrid）
+	 * 第一次读取新的一步时从可读网格增量更新；引用在下一次读取之前保持不变
+	 * @param Lod 细节层级（0 = 全分辨率，1 = 2x，2 = 4x，超出范围时截断）
+	 */
+	const FWorldMorphingGrid& GetLodGrid(int32 Lod) const;
+
+	// ========== 存档 ==========
+
+	/**
+	 * 保存世界（二进制存档，见 FWorldMorphingSaveFormat）
+	 * 完整存档同时成为之后增量存档的关键帧；没有尺寸相同的关键帧时增量存档退化为完整存档
+	 * @param OutData 输出数据
+	 * @param bDelta 是否保存为相对关键帧的增量
+	 * @return 世界未初始化或过大（无法存档）时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Save")
+	bool SaveWorldSnapshot(TArray<uint8>& OutData, bool bDelta = false);
+
+	/**
+	 * 加载世界（完整存档同时成为关键帧；增量存档必须基于当前关键帧）
+	 * 模拟参数保持不变
+	 * @param Data 存档数据
+	 * @return 数据无效或关键帧不匹配时返回 false，世界保持不变
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Save")
+	bool LoadWorldSnapshot(const TArray<uint8>& Data);
+
+	/**
+	 * 保存世界到文件
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Save")
+	bool SaveWorldToFile(const FString& FilePath, bool bDelta = false);
+
+	/**
+	 * 从文件加载世界
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WorldMorphing|Save")
+	bool LoadWorldFromFile(const FString& FilePath);
 
-	// 模拟状态
-	int32 TimeStep;
-	int32 CycleCount;
-	FSimulationParams Params;
+	// ========== 分块布局 ==========
+
+	/**
+	 * 把当前可读网格导出为分块布局（只分配包含地形的块）
+	 * @param OutChunks 输出的分块网格
+	 */
+	void ExportChunks(FWorldMorphingChunkedGrid& OutChunks) const;
+
+	/**
+	 * 从分块布局导入网格状态（尺寸可以与当前世界不同；参数、种子和时间步保持不变）
+	 * @param Chunks 分块网格
+	 */
+	void ImportChunks(const FWorldMorphingChunkedGrid& Chunks);
+
+private:
+	// 模拟引擎（同步模式下在调用线程推进，异步模式下只由后台线程访问）
+	FWorldMorphingSim Sim;
 
 	// Perlin噪声生成器
 	TUniquePtr<FPerlinNoise> PerlinNoise;
 
-	// 噪声偏移(用于域扭曲)
-	float NoiseOffsetX;
-	float NoiseOffsetY;
+	// 增量存档的关键帧（最近一次完整保存或加载的量化平面）
+	TArray<uint8> KeyframePlanes;
+
+	// ========== 时间加速 ==========
+
+	// 积压步数最多保留的秒数（模拟跟不上目标频率时丢弃更早的积压，避免越积越多）
+	static constexpr float MaxTimeWarpBacklogSeconds = 0.5f;
+
+	// 实际步数的统计窗口（秒）
+	static constexpr double ThroughputWindowSeconds = 0.5;
+
+	// 目标每秒步数（0 = 关闭），后台线程也会读取
+	std::atomic<float> TimeWarpStepsPerSecond{ 0.0f };
+	float TimeWarpBudgetMs = 8.0f;
+
+	// 留到下一帧的步数（同步模式）
+	float TimeWarpBacklog = 0.0f;
+
+	// 实际每秒步数（写入端: 推进模拟的线程）
+	std::atomic<float> AchievedStepsPerSecond{ 0.0f };
+
+	// 统计窗口（只由推进模拟的线程访问）
+	double ThroughputWindowStart = 0.0;
+	int32 ThroughputWindowSteps = 0;
+
+	/**
+	 * 记录推进的步数，统计窗口结束时刷新实际每秒步数
+	 * @param Steps 步数
+	 * @param Now 当前时间（秒）
+	 */
+	void RecordThroughput(int32 Steps, double Now);
+
+	// 降采样层级（游戏线程按需更新）
+	mutable FWorldMorphingLodGrid LodGrid;
+
+	// 降采样层级对应的世界版本和时间步（世界被初始化、加载或导入时版本递增）
+	int32 WorldRevision = 0;
+	mutable int32 LodRevision = -1;
+	mutable int32 LodTimeStep = -1;
+
+	// 同步模式下汇总块级活跃度的临时缓冲（游戏线程复用）
+	mutable TArray<uint8> ActivityTileScratch;
+
+	// ========== 异步模拟 ==========
+	friend class FWorldMorphingAsyncWorker;
+
+	// 快照三缓冲（写入端: 后台线程，读取端: 游戏线程）
+	mutable FWorldMorphingSnapshotBuffer Snapshots;
+
+	// 后台线程
+	FRunnable* AsyncWorker = nullptr;
+	FRunnableThread* AsyncThread = nullptr;
+	std::atomic<bool> bAsyncStopRequested{ false };
+	std::atomic<float> AsyncStepsPerSecond{ 60.0f };
+
+	// 异步模式下待应用的参数（后台线程在两步之间取走）
+	mutable FCriticalSection ParamsLock;
+	TOptional<FSimulationParams> PendingParams;
 
-	// 边缘供给点
-	TArray<FEdgeSupplyPoint> EdgeSupplyPoints;
+	/** 把当前网格复制到后台快照并发布 */
+	void PublishSnapshot();
 
-	// 更新各层
-	void UpdateMantleLayer();
-	void UpdateClimateLayer();
-	void UpdateCrystalLayer();
-	void UpdateHumanLayer();
+	/** 应用异步模式下排队的参数 */
+	void ApplyPendingParams();
 
-	// 辅助函数
-	TArray<FCell*> GetNeighbors(int32 X, int32 Y);
-	TArray<const FCell*> GetNeighbors(int32 X, int32 Y) const;
-	bool IsValidCoord(int32 X, int32 Y) const;
+	/** 后台线程主循环 */
+	uint32 RunAsyncLoop();
 };
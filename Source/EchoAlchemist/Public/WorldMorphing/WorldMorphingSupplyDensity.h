@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 边缘供给密度
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 边缘供给点数据
+ */
+struct FEdgeSupplyPoint
+{
+	float Angle;
+	float Speed;
+
+	FEdgeSupplyPoint() : Angle(0.0f), Speed(0.0f) {}
+	FEdgeSupplyPoint(float InAngle, float InSpeed) : Angle(InAngle), Speed(InSpeed) {}
+};
+
+/**
+ * 边缘供给的角度密度查找表
+ *
+ * 某个角度的密度是所有供给点的高斯影响之和（按圆周距离）。
+ * 每步根据供给点构建一张 NumBins 个分箱的密度表，单元格查表并在相邻分箱间线性插值；
+ * 高斯核本身也按分箱距离预先制表（只在宽度改变时重建），构建密度表时不需要超越函数。
+ */
+class ECHOALCHEMIST_API FWorldMorphingSupplyDensity
+{
+public:
+	// 分箱数量（2的幂，下标回绕用位与）
+	static constexpr int32 NumBins = 1024;
+
+	/**
+	 * 根据供给点重建密度表
+	 * @param Points 供给点（角度在 [0, 2π] 内）
+	 * @param Sigma 高斯宽度（弧度）
+	 */
+	void Build(TConstArrayView<FEdgeSupplyPoint> Points, float Sigma);
+
+	/**
+	 * 查询某角度的供给密度
+	 * @param Angle 角度（弧度，[0, 2π)）
+	 */
+	float Sample(float Angle) const
+	{
+		const float Position = Angle * BinsPerRadian;
+		const int32 Bin = FMath::FloorToInt32(Position);
+		const float Alpha = Position - Bin;
+		return FMath::Lerp(Density[Bin & (NumBins - 1)], Density[(Bin + 1) & (NumBins - 1)], Alpha);
+	}
+
+	/**
+	 * 直接计算某角度的供给密度（逐点求 Exp，用于校验）
+	 */
+	static float Evaluate(TConstArrayView<FEdgeSupplyPoint> Points, float Sigma, float Angle);
+
+private:
+	static constexpr float BinsPerRadian = NumBins / (2.0f * PI);
+
+	// 各分箱的密度
+	TArray<float> Density;
+
+	// 高斯核（下标为分箱距离，0..NumBins/2+1）
+	TArray<float> Kernel;
+	float KernelSigma = -1.0f;
+};
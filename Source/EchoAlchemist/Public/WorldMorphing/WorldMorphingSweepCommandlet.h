@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// 世界变迁系统 - 批量参数实验
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WorldMorphingSweepCommandlet.generated.h"
+
+/**
+ * 世界变迁批量实验命令行
+ *
+ * 同时推进多个互不相关的世界（各自的参数和种子），每个世界单线程运行、世界之间占满所有核心，
+ * 按固定间隔采样世界统计，最后把所有世界的统计时间序列写入一个CSV（World, Seed, Step, 各统计列）。
+ *
+ * 用法：
+ *   UnrealEditor-Cmd <Project> -run=WorldMorphingSweep [-Worlds=16] [-Steps=1000] [-Size=128 | -Width= -Height=]
+ *       [-Seed=1] [-Preset=Default] [-Interval=10] [-ParamsFile=<csv>] [-Output=<csv>]
+ *
+ * - 每个世界的种子为 Seed + 世界序号（ParamsFile 中给出 RandomSeed 列时以其为准）
+ * - ParamsFile: 首行为 FSimulationParams 的属性名，之后每行一个世界，未列出的属性取预设值；给出时忽略 -Worlds
+ * - Output 默认为 Saved/WorldMorphing/Sweep.csv
+ */
+UCLASS()
+class ECHOALCHEMIST_API UWorldMorphingSweepCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UWorldMorphingSweepCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -170,73 +170,11 @@ struct FSimulationParams
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Human")
 	float HumanMigrationThreshold = 40.0f;
-};
-
-/**
- * 内部单元格数据
- * 用于模拟引擎内部存储,不暴露给蓝图
- */
-struct FCell
-{
-	int32 X;
-	int32 Y;
-
-	// 地幔层
-	bool bExists;
-	float MantleEnergy;
-	float ExpansionPotential;
-	float ExpansionAccumulator;
-	float ShrinkAccumulator;
 
-	// 气候层
-	float Temperature;
-	float BaseTemperature;
-	float TemperatureChange;
-	bool bHasThunderstorm;
-
-	// 晶石层
-	ECrystalType CrystalState;
-	float CrystalEnergy;
-	float StoredEnergy;
-	bool bIsAbsorbing;
-	TArray<FVector> EnergyFlow;
-
-	// 人类层
-	float Prosperity;
-
-	FCell()
-		: X(0), Y(0)
-		, bExists(false)
-		, MantleEnergy(0.0f)
-		, ExpansionPotential(0.0f)
-		, ExpansionAccumulator(0.0f)
-		, ShrinkAccumulator(0.0f)
-		, Temperature(0.0f)
-		, BaseTemperature(0.0f)
-		, TemperatureChange(0.0f)
-		, bHasThunderstorm(false)
-		, CrystalState(ECrystalType::Empty)
-		, CrystalEnergy(0.0f)
-		, StoredEnergy(10.0f)
-		, bIsAbsorbing(false)
-		, Prosperity(0.0f)
-	{
-	}
-
-	// 转换为蓝图可读的状态
-	FCellState ToBlueprintState() const
-	{
-		FCellState State;
-		State.bExists = bExists;
-		State.MantleEnergy = MantleEnergy;
-		State.Temperature = Temperature;
-		State.bHasThunderstorm = bHasThunderstorm;
-		State.CrystalType = CrystalState;
-		State.StoredEnergy = StoredEnergy;
-		State.bIsAbsorbing = bIsAbsorbing;
-		State.Prosperity = Prosperity;
-		return State;
-	}
+	// ========== 模拟控制 ==========
+	// 随机种子（0 表示初始化时随机选择；相同种子的模拟结果与线程数无关）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation")
+	int32 RandomSeed = 0;
 };
 
 /**
@@ -265,6 +203,10 @@ struct FSimulationStatus
 
 	UPROPERTY(BlueprintReadOnly, Category = "Status")
 	int32 CycleCount = 0;
+
+	// 实际达到的每秒模拟步数
+	UPROPERTY(BlueprintReadOnly, Category = "Status")
+	float StepsPerSecond = 0.0f;
 };
 
 /**
@@ -310,7 +252,8 @@ enum class EHeatmapDataType : uint8
 	MantleEnergy    UMETA(DisplayName = "Mantle Energy"),
 	Temperature     UMETA(DisplayName = "Temperature"),
 	CrystalDensity  UMETA(DisplayName = "Crystal Density"),
-	HumanDensity    UMETA(DisplayName = "Human Density")
+	HumanDensity    UMETA(DisplayName = "Human Density"),
+	Activity        UMETA(DisplayName = "Activity (Debug)")
 };
 
 /**
@@ -8,6 +8,9 @@
 #include "WorldMorphing/WorldMorphingTypes.h"
 #include "WorldMorphingVisualization.generated.h"
 
+struct FWorldMorphingGrid;
+class UWorldMorphingSubsystem;
+
 /**
  * 世界变迁系统 - 视觉呈现
  * 负责获取世界状态数据用于渲染和可视化
@@ -36,13 +39,26 @@ public:
 	 * @param StartY 起始Y坐标
 	 * @param Width 区域宽度
 	 * @param Height 区域高度
+	 * @param Lod 细节层级（0 = 全分辨率，1 = 2x，2 = 4x；坐标和尺寸都以该层级的单元格为单位）
 	 * @return 单元格状态数组
 	 */
 	UFUNCTION(BlueprintPure, Category = "WorldMorphing|Visualization", 
 	          meta = (WorldContext = "WorldContextObject"))
 	static TArray<FCellState> GetRegionStates(UObject* WorldContextObject, 
 	                                           int32 StartX, int32 StartY, 
-	                                           int32 Width, int32 Height);
+	                                           int32 Width, int32 Height,
+	                                           int32 Lod = 0);
+
+	/**
+	 * 获取某个细节层级的网格尺寸
+	 * @param WorldContextObject 世界上下文对象
+	 * @param Lod 细节层级
+	 * @param OutWidth 宽度
+	 * @param OutHeight 高度
+	 */
+	UFUNCTION(BlueprintPure, Category = "WorldMorphing|Visualization", 
+	          meta = (WorldContext = "WorldContextObject"))
+	static void GetLodSize(UObject* WorldContextObject, int32 Lod, int32& OutWidth, int32& OutHeight);
 
 	/**
 	 * 获取整个世界的统计信息
@@ -57,10 +73,44 @@ public:
 	 * 获取热力图数据（用于调试可视化）
 	 * @param WorldContextObject 世界上下文对象
 	 * @param DataType 数据类型（地幔能量、温度、晶石等）
+	 * @param Lod 细节层级（战略地图等全景视图使用降采样层级）
 	 * @return 热力图数据（归一化到0-1）
 	 */
 	UFUNCTION(BlueprintPure, Category = "WorldMorphing|Visualization", 
 	          meta = (WorldContext = "WorldContextObject"))
 	static TArray<float> GetHeatmapData(UObject* WorldContextObject, 
-	                                     EHeatmapDataType DataType);
+	                                     EHeatmapDataType DataType,
+	                                     int32 Lod = 0);
+
+	/**
+	 * 把热力图直接写入调用方提供的缓冲（原生接口，每帧刷新时不分配内存）
+	 * @param WorldContextObject 世界上下文对象
+	 * @param DataType 数据类型
+	 * @param OutHeatmap 输出缓冲（行主序，大小必须为该层级的宽 * 高，见 GetLodSize）
+	 * @param Lod 细节层级
+	 * @return 子系统不存在或缓冲大小不符时返回 false
+	 */
+	static bool WriteHeatmapData(UObject* WorldContextObject, EHeatmapDataType DataType, TArrayView<float> OutHeatmap, int32 Lod = 0);
+
+	/**
+	 * 同 WriteHeatmapData，直接读取指定的子系统（不经过世界上下文解析）
+	 * @param Subsystem 子系统
+	 * @param DataType 数据类型
+	 * @param OutHeatmap 输出缓冲（大小必须为该层级的宽 * 高）
+	 * @param Lod 细节层级
+	 * @return 子系统为空或缓冲大小不符时返回 false
+	 */
+	static bool WriteSubsystemHeatmapData(const UWorldMorphingSubsystem* Subsystem, EHeatmapDataType DataType, TArrayView<float> OutHeatmap, int32 Lod = 0);
+
+	/**
+	 * 归一化网格一行中的一段（原生接口，热力图缓冲和热力图纹理共用）
+	 * Activity 是块级调试数据（见 UWorldMorphingSubsystem::GetActivityHeatmap），这里输出0
+	 * @param Grid 网格
+	 * @param DataType 数据类型
+	 * @param Y 行
+	 * @param BeginX 起始列
+	 * @param EndX 结束列（不含）
+	 * @param OutRow 输出（EndX - BeginX 个值）
+	 */
+	static void NormalizeHeatmapRow(const FWorldMorphingGrid& Grid, EHeatmapDataType DataType, int32 Y, int32 BeginX, int32 EndX, float* OutRow);
 };
@@ -0,0 +1,82 @@
+// Copyright Echo Alchemist Game. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Combat/CircularSceneManager.h"
+
+// 测试：批量角度推进与逐个计算结果一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCircularSceneBatchAngleTest,
+	"EchoAlchemist.Combat.CircularSceneManager.BatchAngles",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCircularSceneBatchAngleTest::RunTest(const FString& Parameters)
+{
+	UCircularSceneManager* Scene = NewObject<UCircularSceneManager>();
+	Scene->Initialize(300.0f, 500.0f);
+	Scene->SetCenter(FVector(100.0f, -50.0f, 20.0f));
+
+	// 7个角度：覆盖一个完整的4路批次和一个不完整的尾部批次，包含负角度和超过2π的角度
+	TArray<float> Angles = { 0.0f, 0.5f, 3.0f, 6.2f, -1.0f, 7.5f, 2.0f * PI - 0.01f };
+	const TArray<float> Original = Angles;
+	TArray<FVector> Positions;
+	Positions.SetNum(Angles.Num());
+
+	const float AngularVelocity = 0.5f;
+	const float DeltaTime = 0.1f;
+	Scene->AdvanceEnemyAngles(Angles, AngularVelocity, DeltaTime, Positions);
+
+	for (int32 i = 0; i < Angles.Num(); ++i)
+	{
+		const float ExpectedAngle = Scene->UpdateEnemyAngle(Original[i], AngularVelocity, DeltaTime);
+		const FVector ExpectedPosition = Scene->GetEnemyPosition(ExpectedAngle);
+
+		TestTrue(FString::Printf(TEXT("Angle %d normalized"), i), Angles[i] >= 0.0f && Angles[i] < 2.0f * PI);
+		TestTrue(FString::Printf(TEXT("Angle %d matches"), i),
+			FMath::Abs(UCircularSceneManager::AngleDifference(Angles[i], ExpectedAngle)) < 1e-4f);
+		TestTrue(FString::Printf(TEXT("Position %d matches"), i), Positions[i].Equals(ExpectedPosition, 0.01f));
+	}
+
+	return true;
+}
+
+// 测试：批量边界反弹与逐个处理结果一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCircularSceneBatchBoundaryTest,
+	"EchoAlchemist.Combat.CircularSceneManager.BatchBoundary",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCircularSceneBatchBoundaryTest::RunTest(const FString& Parameters)
+{
+	UCircularSceneManager* Scene = NewObject<UCircularSceneManager>();
+	Scene->Initialize(300.0f, 500.0f);
+
+	// 圆环内、超出外半径、小于内半径
+	TArray<FVector> Positions = { FVector(400, 0, 0), FVector(0, 600, 0), FVector(-100, -100, 0), FVector(350, 350, 0) };
+	TArray<FVector> Velocities = { FVector(10, 5, 0), FVector(3, 50, 0), FVector(-20, -10, 0), FVector(40, 40, 0) };
+
+	TArray<FVector> ExpectedPositions = Positions;
+	TArray<FVector> ExpectedVelocities = Velocities;
+	for (int32 i = 0; i < ExpectedPositions.Num(); ++i)
+	{
+		Scene->HandleBoundaryInteraction(ExpectedPositions[i], ExpectedVelocities[i]);
+	}
+
+	ISceneManager* SceneInterface = Scene;
+	SceneInterface->HandleBoundaryInteraction(TArrayView<FVector>(Positions), TArrayView<FVector>(Velocities));
+
+	for (int32 i = 0; i < Positions.Num(); ++i)
+	{
+		TestTrue(FString::Printf(TEXT("Position %d matches"), i), Positions[i].Equals(ExpectedPositions[i], 0.01f));
+		TestTrue(FString::Printf(TEXT("Velocity %d matches"), i), Velocities[i].Equals(ExpectedVelocities[i], 0.01f));
+	}
+
+	// 超出外半径的魔药被拉回外半径并反向
+	TestTrue(TEXT("Clamped to outer radius"), FMath::IsNearlyEqual(Positions[1].Size2D(), 500.0, 0.01));
+	TestTrue(TEXT("Velocity reflected inward"), Velocities[1].Y < 0.0f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,119 @@
+// Copyright Echo Alchemist Game. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Combat/CombatSystemInitializer.h"
+#include "Combat/CombatManager.h"
+#include "Combat/CombatPhysicsIntegrator.h"
+#include "Combat/EnemyManager.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	/** 一场固定种子战斗的结果 */
+	struct FIntegratorFightResult
+	{
+		int32 Kills = 0;
+		int32 Hits = 0;
+		float TotalDamage = 0.0f;
+		TArray<FVector> EnemyPositions;
+		TArray<float> EnemyHealth;
+	};
+
+	/**
+	 * 运行一场固定种子的环形场景战斗
+	 * @param bUseTaskGraph 是否使用任务图
+	 */
+	FIntegratorFightResult RunFight(bool bUseTaskGraph)
+	{
+		FIntegratorFightResult Result;
+
+		FCombatConfig Config = FCombatConfig::CreateEasyConfig();
+		Config.VictoryKillCount = 1000;
+
+		UCombatManager* CombatManager = UCombatSystemInitializer::InitializeCombatSystemWithConfig(
+			GetTransientPackage(), Config, ECombatSceneType::Circular);
+		if (!CombatManager)
+		{
+			return Result;
+		}
+
+		UCombatPhysicsIntegrator* Integrator = CombatManager->GetPhysicsIntegrator();
+		UEnemyManager* EnemyManager = Integrator->GetEnemyManager();
+		Integrator->SetUseTaskGraph(bUseTaskGraph);
+		Integrator->SetUpdateEnemies(true);
+		CombatManager->StartCombat();
+
+		FRandomStream Stream(2024);
+		for (int32 i = 0; i < 12; ++i)
+		{
+			EnemyManager->SpawnEnemyAtAngle(EEnemyType::CrystalGolem, Stream.FRandRange(0.0f, 2.0f * PI), 60.0f);
+		}
+		EnemyManager->QueueWave(EEnemyType::CrystalGolem, 8, 60.0f, 4);
+
+		FMarbleLaunchParams LaunchParams;
+		LaunchParams.LaunchPosition = FVector::ZeroVector;
+		LaunchParams.LaunchSpeed = 800.0f;
+		LaunchParams.PotencyMultiplier = 3.0f;
+		LaunchParams.PotionType = EPotionType::Ricochet;
+
+		const float TimeStep = 1.0f / 60.0f;
+		for (int32 Step = 0; Step < 300 && CombatManager->IsInCombat(); ++Step)
+		{
+			FEnemyData Target;
+			if (Step % 15 == 0 && EnemyManager->GetNearestEnemy(LaunchParams.LaunchPosition, Target))
+			{
+				LaunchParams.LaunchDirection = Target.Position - LaunchParams.LaunchPosition;
+				CombatManager->LaunchMarble(LaunchParams);
+			}
+
+			CombatManager->Tick(TimeStep);
+			EnemyManager->RemoveDeadEnemies();
+		}
+
+		Result.Kills = CombatManager->GetKillCount();
+		Result.Hits = Integrator->GetTotalHitCount();
+		for (const TPair<EPotionType, float>& Pair : Integrator->GetDamageByPotionType())
+		{
+			Result.TotalDamage += Pair.Value;
+		}
+		for (const FEnemyData& Enemy : EnemyManager->GetAliveEnemies())
+		{
+			Result.EnemyPositions.Add(Enemy.Position);
+			Result.EnemyHealth.Add(Enemy.Health);
+		}
+
+		return Result;
+	}
+}
+
+// 测试：同一场战斗串行更新和任务图更新的结果一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatPhysicsIntegratorTaskGraphTest,
+	"EchoAlchemist.Combat.CombatPhysicsIntegrator.TaskGraphMatchesSerial",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCombatPhysicsIntegratorTaskGraphTest::RunTest(const FString& Parameters)
+{
+	const FIntegratorFightResult Serial = RunFight(false);
+	const FIntegratorFightResult Parallel = RunFight(true);
+
+	TestTrue(TEXT("Marbles hit enemies"), Serial.Hits > 0);
+	TestEqual(TEXT("Kills match"), Parallel.Kills, Serial.Kills);
+	TestEqual(TEXT("Hits match"), Parallel.Hits, Serial.Hits);
+	TestEqual(TEXT("Damage total matches"), Parallel.TotalDamage, Serial.TotalDamage);
+	TestEqual(TEXT("Alive enemy count matches"), Parallel.EnemyPositions.Num(), Serial.EnemyPositions.Num());
+
+	const int32 Count = FMath::Min(Parallel.EnemyPositions.Num(), Serial.EnemyPositions.Num());
+	for (int32 i = 0; i < Count; ++i)
+	{
+		TestEqual(TEXT("Enemy position matches"), Parallel.EnemyPositions[i], Serial.EnemyPositions[i]);
+		TestEqual(TEXT("Enemy health matches"), Parallel.EnemyHealth[i], Serial.EnemyHealth[i]);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,78 @@
+// Copyright Echo Alchemist Game. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Combat/CombatSimulator.h"
+
+// 测试：汇总统计
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatSimulatorAggregateTest,
+	"EchoAlchemist.Combat.CombatSimulator.Aggregate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCombatSimulatorAggregateTest::RunTest(const FString& Parameters)
+{
+	TArray<FCombatSimulationResult> Results;
+	Results.SetNum(3);
+
+	Results[0].bVictory = true;
+	Results[0].Kills = 20;
+	Results[0].CombatTime = 30.0f;
+	Results[0].DamageByPotionType.Add(EPotionType::Ricochet, 300.0f);
+
+	Results[1].bVictory = true;
+	Results[1].Kills = 20;
+	Results[1].CombatTime = 50.0f;
+	Results[1].DamageByPotionType.Add(EPotionType::Explosive, 600.0f);
+
+	Results[2].bVictory = false;
+	Results[2].Kills = 5;
+	Results[2].CombatTime = 120.0f;
+
+	const FCombatSimulationStats Stats = UCombatSimulator::AggregateResults(Results);
+	TestEqual(TEXT("Run count"), Stats.RunCount, 3);
+	TestEqual(TEXT("Victory count"), Stats.VictoryCount, 2);
+	TestEqual(TEXT("Average kills"), Stats.AverageKills, 15.0f);
+	TestEqual(TEXT("Average time to victory"), Stats.AverageTimeToVictory, 40.0f);
+	TestEqual(TEXT("Min time to victory"), Stats.MinTimeToVictory, 30.0f);
+	TestEqual(TEXT("Max time to victory"), Stats.MaxTimeToVictory, 50.0f);
+	TestEqual(TEXT("Total simulated seconds"), Stats.TotalSimulatedSeconds, 200.0f);
+	TestEqual(TEXT("Average ricochet damage"), Stats.AverageDamageByPotionType.FindRef(EPotionType::Ricochet), 100.0f);
+	TestEqual(TEXT("Average explosive damage"), Stats.AverageDamageByPotionType.FindRef(EPotionType::Explosive), 200.0f);
+
+	return true;
+}
+
+// 测试：批量模拟返回每场结果
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatSimulatorBatchTest,
+	"EchoAlchemist.Combat.CombatSimulator.Batch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCombatSimulatorBatchTest::RunTest(const FString& Parameters)
+{
+	FCombatSimulationParams Params;
+	Params.Config = FCombatConfig::CreateEasyConfig();
+	Params.DurationSeconds = 5.0f;
+	Params.RandomSeed = 42;
+	Params.PotionLoadout = { EPotionType::Ricochet, EPotionType::Piercing };
+
+	TArray<FCombatSimulationResult> Results;
+	const FCombatSimulationStats Stats = UCombatSimulator::SimulateCombatBatch(Params, 6, Results);
+
+	TestEqual(TEXT("One result per run"), Results.Num(), 6);
+	TestEqual(TEXT("Stats cover all runs"), Stats.RunCount, 6);
+	TestTrue(TEXT("Victory count bounded"), Stats.VictoryCount <= Stats.RunCount);
+
+	for (int32 i = 0; i < Results.Num(); ++i)
+	{
+		TestEqual(TEXT("Seed follows run index"), Results[i].Seed, 42 + i);
+		TestTrue(TEXT("Combat time within duration"), Results[i].CombatTime <= Params.DurationSeconds + Params.TimeStep);
+		TestTrue(TEXT("Marbles were launched"), Results[i].MarblesLaunched > 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,187 @@
+// Copyright Echo Alchemist Game. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Combat/EnemyManager.h"
+#include "Combat/CircularSceneManager.h"
+#include "Combat/EnemySpatialIndex.h"
+
+// 测试：波次分帧生成
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyManagerWaveSpawnTest, 
+	"EchoAlchemist.Combat.EnemyManager.WaveSpawn", 
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEnemyManagerWaveSpawnTest::RunTest(const FString& Parameters)
+{
+	// 创建环形场景
+	UCircularSceneManager* Scene = NewObject<UCircularSceneManager>();
+	Scene->Initialize(300.0f, 500.0f);
+
+	UEnemyManager* EnemyManager = NewObject<UEnemyManager>();
+	EnemyManager->Initialize(TScriptInterface<ISceneManager>(Scene));
+
+	// 10个敌人分4帧生成：3 + 3 + 2 + 2
+	const int32 Queued = EnemyManager->QueueWave(EEnemyType::EliteGolem, 10, 200.0f, 4);
+	TestEqual(TEXT("Whole wave should be queued"), Queued, 10);
+	TestEqual(TEXT("No enemy spawned before processing"), EnemyManager->GetEnemyCount(), 0);
+	TestEqual(TEXT("Pending count should be 10"), EnemyManager->GetPendingSpawnCount(), 10);
+
+	TestEqual(TEXT("Frame 1 quota"), EnemyManager->ProcessSpawnQueue(), 3);
+	TestEqual(TEXT("Frame 2 quota"), EnemyManager->ProcessSpawnQueue(), 3);
+	TestEqual(TEXT("Frame 3 quota"), EnemyManager->ProcessSpawnQueue(), 2);
+	TestEqual(TEXT("Frame 4 quota"), EnemyManager->ProcessSpawnQueue(), 2);
+	TestEqual(TEXT("Queue should be drained"), EnemyManager->GetPendingSpawnCount(), 0);
+	TestEqual(TEXT("All enemies spawned"), EnemyManager->GetAliveEnemyCount(), 10);
+
+	// 属性来自模板
+	TArray<FEnemyData> Enemies = EnemyManager->GetAliveEnemies();
+	TestEqual(TEXT("Name should come from template"), Enemies[0].Name, FString(TEXT("Elite Golem")));
+	TestEqual(TEXT("Health should be set"), Enemies[0].MaxHealth, 200.0f);
+
+	// ID唯一
+	TSet<FGuid> IDs;
+	for (const FEnemyData& Enemy : Enemies)
+	{
+		IDs.Add(Enemy.ID);
+	}
+	TestEqual(TEXT("IDs should be unique"), IDs.Num(), 10);
+
+	return true;
+}
+
+// 测试：死亡敌人回收到对象池并被复用
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyManagerPoolRecycleTest, 
+	"EchoAlchemist.Combat.EnemyManager.PoolRecycle", 
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEnemyManagerPoolRecycleTest::RunTest(const FString& Parameters)
+{
+	UCircularSceneManager* Scene = NewObject<UCircularSceneManager>();
+	Scene->Initialize(300.0f, 500.0f);
+
+	UEnemyManager* EnemyManager = NewObject<UEnemyManager>();
+	EnemyManager->Initialize(TScriptInterface<ISceneManager>(Scene));
+
+	TArray<FGuid> IDs = EnemyManager->SpawnEnemies(EEnemyType::CrystalGolem, 4, 100.0f);
+	TestEqual(TEXT("4 enemies spawned"), EnemyManager->GetEnemyCount(), 4);
+
+	// 杀死第1和第3个
+	EnemyManager->ApplyDamageToEnemy(IDs[0], 1000.0f);
+	EnemyManager->ApplyDamageToEnemy(IDs[2], 1000.0f);
+
+	TestEqual(TEXT("2 dead enemies removed"), EnemyManager->RemoveDeadEnemies(), 2);
+	TestEqual(TEXT("2 enemies remain"), EnemyManager->GetEnemyCount(), 2);
+	TestEqual(TEXT("2 slots in pool"), EnemyManager->GetPooledEnemyCount(), 2);
+
+	// 存活敌人保持原有顺序
+	TArray<FEnemyData> Alive = EnemyManager->GetAliveEnemies();
+	TestEqual(TEXT("Order preserved (first)"), Alive[0].ID, IDs[1]);
+	TestEqual(TEXT("Order preserved (second)"), Alive[1].ID, IDs[3]);
+
+	// 新波次复用池中槽位
+	EnemyManager->QueueWave(EEnemyType::BossGolem, 2, 500.0f, 1);
+	EnemyManager->ProcessSpawnQueue();
+	TestEqual(TEXT("Pool should be consumed"), EnemyManager->GetPooledEnemyCount(), 0);
+	TestEqual(TEXT("4 enemies alive again"), EnemyManager->GetAliveEnemyCount(), 4);
+
+	return true;
+}
+
+// 测试：空间查询结果与暴力遍历一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyManagerSpatialQueryTest, 
+	"EchoAlchemist.Combat.EnemyManager.SpatialQuery", 
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEnemyManagerSpatialQueryTest::RunTest(const FString& Parameters)
+{
+	UCircularSceneManager* Scene = NewObject<UCircularSceneManager>();
+	Scene->Initialize(300.0f, 500.0f);
+
+	UEnemyManager* EnemyManager = NewObject<UEnemyManager>();
+	EnemyManager->Initialize(TScriptInterface<ISceneManager>(Scene));
+	EnemyManager->SpawnEnemies(EEnemyType::CrystalGolem, 40, 100.0f);
+
+	const TArray<FEnemyData> Alive = EnemyManager->GetAliveEnemies();
+	const FVector QueryPositions[] = { FVector(0, 0, 0), FVector(300, 0, 0), FVector(-250, 200, 0), FVector(0, -480, 0) };
+
+	for (const FVector& Query : QueryPositions)
+	{
+		// 暴力计算最近敌人和半径内数量
+		float BestDistSquared = FLT_MAX;
+		FGuid BestID;
+		int32 InRadius = 0;
+		for (const FEnemyData& Enemy : Alive)
+		{
+			const float DistSquared = FVector::DistSquared(Query, Enemy.Position);
+			if (DistSquared < BestDistSquared)
+			{
+				BestDistSquared = DistSquared;
+				BestID = Enemy.ID;
+			}
+			if (DistSquared <= FMath::Square(250.0f))
+			{
+				InRadius++;
+			}
+		}
+
+		FEnemyData Nearest;
+		TestTrue(TEXT("Nearest enemy found"), EnemyManager->GetNearestEnemy(Query, Nearest));
+		TestEqual(TEXT("Nearest matches brute force"), Nearest.ID, BestID);
+		TestEqual(TEXT("Radius query matches brute force"), EnemyManager->GetEnemiesInRadius(Query, 250.0f).Num(), InRadius);
+
+		// K近邻按距离排序
+		TArray<FEnemyData> KNearest = EnemyManager->GetNearestEnemies(Query, 5);
+		TestEqual(TEXT("K nearest count"), KNearest.Num(), 5);
+		TestEqual(TEXT("K nearest starts with nearest"), KNearest[0].ID, BestID);
+		for (int32 i = 1; i < KNearest.Num(); ++i)
+		{
+			TestTrue(TEXT("K nearest sorted"), 
+				FVector::DistSquared(Query, KNearest[i - 1].Position) <= FVector::DistSquared(Query, KNearest[i].Position));
+		}
+	}
+
+	// 死亡敌人不应出现在查询结果中
+	EnemyManager->ApplyDamageToEnemy(Alive[0].ID, 1000.0f);
+	FEnemyData Nearest;
+	EnemyManager->GetNearestEnemy(Alive[0].Position, Nearest);
+	TestNotEqual(TEXT("Dead enemy excluded"), Nearest.ID, Alive[0].ID);
+
+	return true;
+}
+
+// 测试：网格分桶的K近邻
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemySpatialIndexGridTest, 
+	"EchoAlchemist.Combat.EnemySpatialIndex.Grid", 
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FEnemySpatialIndexGridTest::RunTest(const FString& Parameters)
+{
+	FEnemySpatialIndex Index;
+	Index.BeginGrid(100.0f);
+	for (int32 i = 0; i < 10; ++i)
+	{
+		Index.Add(i, FVector(i * 150.0f, 0.0f, 0.0f));
+	}
+	Index.Finalize();
+
+	TArray<int32> Result;
+	TestEqual(TEXT("3 nearest found"), Index.QueryKNearest(FVector(620.0f, 0.0f, 0.0f), 3, 0.0f, Result), 3);
+	TestEqual(TEXT("Nearest"), Result[0], 4);
+	TestEqual(TEXT("Second"), Result[1], 3);
+	TestEqual(TEXT("Third"), Result[2], 5);
+
+	// 查询点在网格外
+	TestEqual(TEXT("Outside query"), Index.QueryKNearest(FVector(5000.0f, 0.0f, 0.0f), 1, 0.0f, Result), 1);
+	TestEqual(TEXT("Outside nearest"), Result[0], 9);
+
+	// 最大半径限制
+	TestEqual(TEXT("Max radius limits result"), Index.QueryKNearest(FVector(0.0f, 0.0f, 0.0f), 5, 200.0f, Result), 2);
+	TestEqual(TEXT("Radius query"), Index.QueryRadius(FVector(300.0f, 0.0f, 0.0f), 150.0f, Result), 3);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
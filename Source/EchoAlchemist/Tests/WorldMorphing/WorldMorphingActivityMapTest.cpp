@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingActivityMap.h"
+
+// 测试：活跃块、扩展和冷却
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingActivityMapTilesTest,
+	"EchoAlchemist.WorldMorphing.ActivityMap.Tiles",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingActivityMapTilesTest::RunTest(const FString& Parameters)
+{
+	// 4x4 个块，最后一列块不完整
+	const int32 Width = 60;
+	const int32 Height = 64;
+
+	FWorldMorphingGrid Grid;
+	Grid.Init(Width, Height);
+
+	auto IsAlpha = [&Grid](int32 Index)
+	{
+		return Grid.CrystalState[Index] == ECrystalType::Alpha;
+	};
+
+	auto CountSpanCells = [&Grid](const FWorldMorphingActivityMap& Map)
+	{
+		int32 Cells = 0;
+		for (int32 TileY = 0; TileY < Map.GetTilesY(); ++TileY)
+		{
+			Map.ForEachSpan(Grid, TileY, [&Cells](int32 BeginIndex, int32 EndIndex)
+			{
+				Cells += EndIndex - BeginIndex;
+			});
+		}
+		return Cells;
+	};
+
+	FWorldMorphingActivityMap Map;
+	Map.Init(Width, Height);
+	TestEqual(TEXT("Tiles X"), Map.GetTilesX(), 4);
+	TestEqual(TEXT("Tiles Y"), Map.GetTilesY(), 4);
+	TestEqual(TEXT("Everything processed before the first refresh"), CountSpanCells(Map), Width * Height);
+
+	// 空网格刷新后没有活跃块
+	Map.Refresh(Grid, IsAlpha, 1);
+	Map.Refresh(Grid, IsAlpha, 1);
+	TestFalse(TEXT("Empty grid is idle"), Map.HasActiveTiles());
+	TestEqual(TEXT("Empty grid processes nothing"), CountSpanCells(Map), 0);
+
+	// 处理集合之外出现的活跃单元格需要显式标记
+	const int32 Cell = Grid.ToIndex(20, 5);
+	Grid.CrystalState[Cell] = ECrystalType::Alpha;
+	Map.MarkCell(Grid, Cell);
+	Map.Refresh(Grid, IsAlpha, 1);
+	TestTrue(TEXT("Tile (1, 0) active"), Map.IsActive(1, 0));
+	TestTrue(TEXT("Neighbour tile processed"), Map.IsProcessed(2, 1));
+	TestFalse(TEXT("Far tile skipped"), Map.IsProcessed(3, 0));
+	TestEqual(TEXT("3x2 tiles processed"), CountSpanCells(Map), 3 * 16 * 2 * 16);
+
+	// 活跃单元格消失后再处理一步，然后停止
+	Grid.CrystalState[Cell] = ECrystalType::Beta;
+	Map.Refresh(Grid, IsAlpha, 1);
+	TestFalse(TEXT("No active tiles"), Map.HasActiveTiles());
+	TestTrue(TEXT("Cooldown keeps tile processed"), Map.IsProcessed(1, 0));
+	Map.Refresh(Grid, IsAlpha, 1);
+	TestEqual(TEXT("Idle after cooldown"), CountSpanCells(Map), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
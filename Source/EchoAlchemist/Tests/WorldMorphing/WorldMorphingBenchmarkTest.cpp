@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingSubsystem.h"
+
+namespace
+{
+	/**
+	 * 基准场景：固定尺寸、步数和种子
+	 * GoldenHash 是该场景结束时 FWorldMorphingGrid::ComputeHash 的值，必须取自目标平台上真实的自动化测试运行；
+	 * 为0表示尚未记录。规则有意改变时，把日志中的当前值更新到这里并在提交说明中注明。
+	 */
+	struct FWorldMorphingBenchmarkCase
+	{
+		int32 Size;
+		int32 Steps;
+		int32 Seed;
+		uint32 GoldenHash;
+	};
+
+	const FWorldMorphingBenchmarkCase BenchmarkCases[] =
+	{
+		{   64, 400, 1001, 0 },
+		{  256, 100, 1002, 0 },
+		{  512,  50, 1003, 0 },
+		{ 1024,  20, 1004, 0 },
+	};
+
+	// 黄金值在目标平台上记录并核对之前，缺失和不一致只给出警告和当前值；核对后改为 true，两者都成为错误
+	constexpr bool bGoldenHashesVerified = false;
+}
+
+// 测试：各尺寸下逐层耗时和吞吐量，最终网格哈希与记录的黄金值一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingBenchmarkTest,
+	"EchoAlchemist.WorldMorphing.Benchmark.LayersAndGolden",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FWorldMorphingBenchmarkTest::RunTest(const FString& Parameters)
+{
+	for (const FWorldMorphingBenchmarkCase& Case : BenchmarkCases)
+	{
+		FSimulationParams Params;
+		Params.RandomSeed = Case.Seed;
+
+		UWorldMorphingSubsystem* Subsystem = NewObject<UWorldMorphingSubsystem>();
+		Subsystem->InitializeWorld(Case.Size, Case.Size, Params);
+		Subsystem->ResetLayerTimings();
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Step = 0; Step < Case.Steps; ++Step)
+		{
+			Subsystem->TickSimulation(0.016f);
+		}
+		const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const FWorldMorphingLayerTimings& Timings = Subsystem->GetLayerTimings();
+		TestEqual(FString::Printf(TEXT("%dx%d steps"), Case.Size, Case.Size), Timings.Steps, Case.Steps);
+
+		const double MsPerStep = 1000.0 / FMath::Max(Timings.Steps, 1);
+		const double CellsPerSecond = static_cast<double>(Case.Size) * Case.Size * Case.Steps / FMath::Max(TotalSeconds, 1e-9);
+		AddInfo(FString::Printf(TEXT("%dx%d: mantle %.3f ms, climate %.3f ms, crystal %.3f ms, human %.3f ms per tick; %.2f M cells/s"),
+			Case.Size, Case.Size,
+			Timings.MantleSeconds * MsPerStep, Timings.ClimateSeconds * MsPerStep,
+			Timings.CrystalSeconds * MsPerStep, Timings.HumanSeconds * MsPerStep,
+			CellsPerSecond / 1e6));
+
+		const uint32 Hash = Subsystem->GetReadGrid().ComputeHash();
+		FString Mismatch;
+		if (Case.GoldenHash == 0)
+		{
+			Mismatch = FString::Printf(TEXT("%dx%d: no golden hash recorded, current 0x%08X"), Case.Size, Case.Size, Hash);
+		}
+		else if (Hash != Case.GoldenHash)
+		{
+			Mismatch = FString::Printf(TEXT("%dx%d: grid hash 0x%08X differs from golden 0x%08X"), Case.Size, Case.Size, Hash, Case.GoldenHash);
+		}
+
+		if (!Mismatch.IsEmpty())
+		{
+			if (bGoldenHashesVerified)
+			{
+				AddError(Mismatch);
+			}
+			else
+			{
+				AddWarning(Mismatch);
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
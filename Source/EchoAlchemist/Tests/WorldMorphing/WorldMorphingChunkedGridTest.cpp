@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingChunkedGrid.h"
+#include "WorldMorphing/WorldMorphingKernels.h"
+
+// 测试：分块往返、惰性分配，以及交换光晕后逐块运行内核与平铺网格一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingChunkedGridRoundTripTest,
+	"EchoAlchemist.WorldMorphing.ChunkedGrid.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingChunkedGridRoundTripTest::RunTest(const FString& Parameters)
+{
+	// 4x3 个块，最后一列和最后一行不完整
+	const int32 Width = 120;
+	const int32 Height = 70;
+
+	FWorldMorphingGrid Grid;
+	Grid.Init(Width, Height);
+
+	// 只在左上角放一块跨越块边界的圆形地形
+	FRandomStream Random(11);
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const int32 Index = Grid.ToIndex(X, Y);
+			if (FMath::Square(X - 32) + FMath::Square(Y - 30) < 20 * 20)
+			{
+				Grid.SetFlag(Index, EWorldCellFlags::Exists, true);
+				Grid.MantleEnergy[Index] = Random.FRandRange(0.0f, 100.0f);
+				Grid.Temperature[Index] = Random.FRandRange(-20.0f, 40.0f);
+				Grid.Prosperity[Index] = Random.FRand();
+			}
+		}
+	}
+
+	FWorldMorphingChunkedGrid Chunks;
+	Chunks.FromGrid(Grid);
+	TestEqual(TEXT("Chunks X"), Chunks.GetChunksX(), 4);
+	TestEqual(TEXT("Chunks Y"), Chunks.GetChunksY(), 3);
+	TestEqual(TEXT("Only land chunks allocated"), Chunks.GetNumAllocatedChunks(), 4);
+	TestNull(TEXT("Ocean chunk not allocated"), Chunks.FindChunk(3, 2));
+
+	FWorldMorphingGrid RoundTrip;
+	Chunks.ToGrid(RoundTrip);
+	bool bRoundTripMatches = true;
+	for (int32 Index = 0; Index < Grid.Num() && bRoundTripMatches; ++Index)
+	{
+		bRoundTripMatches = Grid.Flags[Index] == RoundTrip.Flags[Index]
+			&& Grid.MantleEnergy[Index] == RoundTrip.MantleEnergy[Index]
+			&& Grid.Temperature[Index] == RoundTrip.Temperature[Index]
+			&& Grid.Prosperity[Index] == RoundTrip.Prosperity[Index]
+			&& Grid.StoredEnergy[Index] == RoundTrip.StoredEnergy[Index];
+	}
+	TestTrue(TEXT("Round trip preserves every field"), bRoundTripMatches);
+
+	// 平铺网格上的参考结果
+	WorldMorphingKernels::FMantleExchangeParams ExchangeParams;
+	for (int32 Slot = 0; Slot < 8; ++Slot)
+	{
+		ExchangeParams.BiasFlow[Slot] = Slot * 0.01f;
+	}
+
+	TArray<float> ExistsMask;
+	ExistsMask.Init(0.0f, Grid.Num());
+	TArray<float> Expected;
+	Expected.Init(0.0f, Grid.Num());
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		WorldMorphingKernels::BuildExistsMask(Grid.Flags.GetData(), ExistsMask.GetData(), RowStart, Width);
+	}
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		WorldMorphingKernels::MantleExchange(Grid.NeighborOffsets, ExistsMask.GetData(), Grid.MantleEnergy.GetData(), Expected.GetData(), ExchangeParams, RowStart, Width);
+	}
+
+	// 逐块独立运行同一内核
+	TMap<const FWorldMorphingChunk*, TArray<float>> ChunkResults;
+	FCriticalSection ResultsLock;
+	Chunks.ParallelForChunks([&ExchangeParams, &ChunkResults, &ResultsLock](FWorldMorphingChunk& Chunk)
+	{
+		float ChunkMask[FWorldMorphingChunk::CellCount] = {};
+		TArray<float> Out;
+		Out.Init(0.0f, FWorldMorphingChunk::CellCount);
+		for (int32 LocalY = -1; LocalY <= FWorldMorphingChunk::Size; ++LocalY)
+		{
+			WorldMorphingKernels::BuildExistsMask(Chunk.Flags, ChunkMask, FWorldMorphingChunk::ToLocalIndex(-1, LocalY), FWorldMorphingChunk::Pitch);
+		}
+		for (int32 LocalY = 0; LocalY < FWorldMorphingChunk::Size; ++LocalY)
+		{
+			WorldMorphingKernels::MantleExchange(FWorldMorphingChunk::NeighborOffsets, ChunkMask, Chunk.MantleEnergy, Out.GetData(), ExchangeParams, FWorldMorphingChunk::ToLocalIndex(0, LocalY), FWorldMorphingChunk::Size);
+		}
+
+		FScopeLock Lock(&ResultsLock);
+		ChunkResults.Add(&Chunk, MoveTemp(Out));
+	});
+
+	int32 Mismatches = 0;
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const FWorldMorphingChunk* Chunk = Chunks.FindChunk(X / FWorldMorphingChunk::Size, Y / FWorldMorphingChunk::Size);
+			const float Actual = Chunk
+				? ChunkResults[Chunk][FWorldMorphingChunk::ToLocalIndex(X % FWorldMorphingChunk::Size, Y % FWorldMorphingChunk::Size)]
+				: 0.0f;
+			if (!FMath::IsNearlyEqual(Actual, Expected[Grid.ToIndex(X, Y)], 1e-4f))
+			{
+				Mismatches++;
+			}
+		}
+	}
+	TestEqual(TEXT("Per-chunk exchange matches flat grid"), Mismatches, 0);
+
+	// 惰性分配的块用默认值填充
+	FWorldMorphingChunk& Ocean = Chunks.FindOrAddChunk(3, 2);
+	TestEqual(TEXT("New chunk allocated"), Chunks.GetNumAllocatedChunks(), 5);
+	TestEqual(TEXT("Default stored energy"), Ocean.StoredEnergy[FWorldMorphingChunk::ToLocalIndex(0, 0)], 10.0f);
+	TestFalse(TEXT("Default cell has no land"), Ocean.HasLand());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingDistanceField.h"
+
+// 测试：增量修复与完整重建一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingDistanceFieldRepairTest,
+	"EchoAlchemist.WorldMorphing.DistanceField.Repair",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingDistanceFieldRepairTest::RunTest(const FString& Parameters)
+{
+	const int32 Width = 30;
+	const int32 Height = 25;
+	const int32 MaxDistance = 4;
+
+	FRandomStream Stream(42);
+	FWorldMorphingGrid Grid;
+	Grid.Init(Width, Height);
+
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			Grid.SetFlag(Grid.ToIndex(X, Y), EWorldCellFlags::Exists, Stream.FRand() < 0.8f);
+		}
+	}
+
+	FWorldMorphingDistanceField Field;
+	Field.Rebuild(Grid, MaxDistance);
+
+	// 网格边界上的单元格与光晕相邻，总是边缘
+	const int32 Corner = Grid.ToIndex(0, 0);
+	Grid.SetFlag(Corner, EWorldCellFlags::Exists, true);
+	Field.Repair(Grid, Corner);
+	TestEqual(TEXT("Border cell is an edge"), Field.GetDistance(Corner), 0);
+
+	int32 Mismatches = 0;
+	for (int32 Step = 0; Step < 200; ++Step)
+	{
+		const int32 Index = Grid.ToIndex(Stream.RandRange(0, Width - 1), Stream.RandRange(0, Height - 1));
+		Grid.SetFlag(Index, EWorldCellFlags::Exists, !Grid.Exists(Index));
+		Field.Repair(Grid, Index);
+
+		FWorldMorphingDistanceField Reference;
+		Reference.Rebuild(Grid, MaxDistance);
+
+		for (int32 CellIndex = 0; CellIndex < Grid.Num(); ++CellIndex)
+		{
+			if (Grid.Exists(CellIndex) && Field.GetDistance(CellIndex) != Reference.GetDistance(CellIndex))
+			{
+				Mismatches++;
+			}
+		}
+	}
+	TestEqual(TEXT("Repaired field matches rebuild"), Mismatches, 0);
+
+	// 实心区域中心的距离被截断到上限
+	FWorldMorphingGrid Solid;
+	Solid.Init(21, 21);
+	for (int32 Index = 0; Index < Solid.Num(); ++Index)
+	{
+		Solid.SetFlag(Index, EWorldCellFlags::Exists, Solid.IsValid(Index));
+	}
+	Field.Rebuild(Solid, MaxDistance);
+	TestEqual(TEXT("Second ring"), Field.GetDistance(Solid.ToIndex(1, 5)), 1);
+	TestEqual(TEXT("Clamped at centre"), Field.GetDistance(Solid.ToIndex(10, 10)), MaxDistance);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
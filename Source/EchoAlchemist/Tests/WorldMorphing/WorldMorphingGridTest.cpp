@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingGrid.h"
+
+// 测试：平面下标与光晕
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingGridLayoutTest,
+	"EchoAlchemist.WorldMorphing.Grid.Layout",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingGridLayoutTest::RunTest(const FString& Parameters)
+{
+	FWorldMorphingGrid Grid;
+	Grid.Init(5, 3);
+
+	TestEqual(TEXT("Pitch includes halo"), Grid.Pitch, 7);
+	TestEqual(TEXT("Cell count includes halo"), Grid.Num(), 7 * 5);
+	TestEqual(TEXT("Every plane has the same size"), Grid.MantleEnergy.Num(), Grid.Num());
+
+	// 坐标往返转换
+	for (int32 Y = 0; Y < 3; ++Y)
+	{
+		for (int32 X = 0; X < 5; ++X)
+		{
+			const int32 Index = Grid.ToIndex(X, Y);
+			TestEqual(TEXT("X round trip"), Grid.GetX(Index), X);
+			TestEqual(TEXT("Y round trip"), Grid.GetY(Index), Y);
+			TestTrue(TEXT("Interior cell is valid"), Grid.IsValid(Index));
+		}
+	}
+
+	// 光晕单元格无效且不存在
+	int32 HaloCount = 0;
+	for (int32 Index = 0; Index < Grid.Num(); ++Index)
+	{
+		if (!Grid.IsValid(Index))
+		{
+			HaloCount++;
+			TestFalse(TEXT("Halo never exists"), Grid.Exists(Index));
+		}
+	}
+	TestEqual(TEXT("Halo ring size"), HaloCount, Grid.Num() - 5 * 3);
+
+	// 标志位互不影响
+	const int32 Index = Grid.ToIndex(2, 1);
+	Grid.SetFlag(Index, EWorldCellFlags::Exists, true);
+	Grid.SetFlag(Index, EWorldCellFlags::Thunderstorm, true);
+	Grid.SetFlag(Index, EWorldCellFlags::Thunderstorm, false);
+	TestTrue(TEXT("Still valid"), Grid.IsValid(Index));
+	TestTrue(TEXT("Exists set"), Grid.Exists(Index));
+	TestFalse(TEXT("Thunderstorm cleared"), Grid.HasFlag(Index, EWorldCellFlags::Thunderstorm));
+
+	const FCellState State = Grid.GetCellState(Index);
+	TestTrue(TEXT("State exists"), State.bExists);
+	TestEqual(TEXT("Default stored energy"), State.StoredEnergy, 10.0f);
+
+	return true;
+}
+
+// 测试：模板邻域掩码
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingGridStencilTest,
+	"EchoAlchemist.WorldMorphing.Grid.Stencil",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingGridStencilTest::RunTest(const FString& Parameters)
+{
+	FWorldMorphingGrid Grid;
+	Grid.Init(4, 4);
+
+	// 偏移与坐标偏移一致
+	const int32 Center = Grid.ToIndex(1, 1);
+	for (int32 i = 0; i < 8; ++i)
+	{
+		const int32 NIndex = Center + Grid.NeighborOffsets[i];
+		TestEqual(TEXT("Offset X"), Grid.GetX(NIndex), 1 + FWorldMorphingGrid::NeighborDX[i]);
+		TestEqual(TEXT("Offset Y"), Grid.GetY(NIndex), 1 + FWorldMorphingGrid::NeighborDY[i]);
+	}
+
+	// 角落单元格：只有3个邻居在网格内，其余5个落在光晕上
+	const int32 Corner = Grid.ToIndex(0, 0);
+	TestEqual(TEXT("Corner has 3 valid neighbours"), FWorldMorphingGrid::CountNeighbors(Grid.GetNeighborMask(Corner, EWorldCellFlags::Valid)), 3);
+
+	// 右方(槽位4)和下方(槽位6)存在地形，右下(槽位7)为Beta晶石
+	Grid.SetFlag(Grid.ToIndex(2, 1), EWorldCellFlags::Exists, true);
+	Grid.SetFlag(Grid.ToIndex(1, 2), EWorldCellFlags::Exists, true);
+	Grid.CrystalState[Grid.ToIndex(2, 2)] = ECrystalType::Beta;
+
+	const uint8 ExistsMask = Grid.GetNeighborMask(Center, EWorldCellFlags::Exists);
+	TestEqual(TEXT("Exists mask"), static_cast<int32>(ExistsMask), (1 << 4) | (1 << 6));
+	TestEqual(TEXT("Beta mask"), static_cast<int32>(Grid.GetCrystalNeighborMask(Center, ECrystalType::Beta)), 1 << 7);
+
+	// 第N个邻居按偏移顺序
+	TestEqual(TEXT("First existing neighbour"), FWorldMorphingGrid::GetNthNeighbor(ExistsMask, 0), 4);
+	TestEqual(TEXT("Second existing neighbour"), FWorldMorphingGrid::GetNthNeighbor(ExistsMask, 1), 6);
+
+	return true;
+}
+
+// 测试：网格哈希只取决于字段内容
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingGridHashTest,
+	"EchoAlchemist.WorldMorphing.Grid.Hash",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingGridHashTest::RunTest(const FString& Parameters)
+{
+	FWorldMorphingGrid A;
+	FWorldMorphingGrid B;
+	A.Init(6, 5);
+	B.Init(6, 5);
+	TestEqual(TEXT("Identical grids"), A.ComputeHash(), B.ComputeHash());
+
+	B.Prosperity[B.ToIndex(3, 2)] = 1.0f;
+	TestNotEqual(TEXT("Field change"), A.ComputeHash(), B.ComputeHash());
+
+	A.Prosperity[A.ToIndex(3, 2)] = 1.0f;
+	A.CrystalState[A.ToIndex(0, 4)] = ECrystalType::Human;
+	TestNotEqual(TEXT("Crystal change"), A.ComputeHash(), B.ComputeHash());
+
+	FWorldMorphingGrid Transposed;
+	Transposed.Init(5, 6);
+	FWorldMorphingGrid Square;
+	Square.Init(6, 5);
+	TestNotEqual(TEXT("Size is hashed"), Transposed.ComputeHash(), Square.ComputeHash());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
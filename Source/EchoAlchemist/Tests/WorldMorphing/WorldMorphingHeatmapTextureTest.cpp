@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingHeatmapTexture.h"
+#include "WorldMorphing/WorldMorphingGrid.h"
+#include "WorldMorphing/WorldMorphingSubsystem.h"
+
+// 测试：量化写入像素副本，只有变化的区域触发上传
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingHeatmapTextureDirtyTest,
+	"EchoAlchemist.WorldMorphing.HeatmapTexture.Dirty",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingHeatmapTextureDirtyTest::RunTest(const FString& Parameters)
+{
+	const int32 Width = 40;
+	const int32 Height = 30;
+
+	FWorldMorphingGrid Grid;
+	Grid.Init(Width, Height);
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const int32 Index = Grid.ToIndex(X, Y);
+			Grid.SetFlag(Index, EWorldCellFlags::Exists, X < 20);
+			Grid.MantleEnergy[Index] = X * 2.5f;
+		}
+	}
+
+	UWorldMorphingHeatmapTexture* Heatmap = UWorldMorphingHeatmapTexture::CreateHeatmapTexture(Width, Height);
+	TestNotNull(TEXT("Texture created"), Heatmap->GetTexture());
+
+	const FIntRect Full(0, 0, Width, Height);
+	TestTrue(TEXT("First update uploads"), Heatmap->UpdateRegions(Grid, EHeatmapDataType::MantleEnergy, MakeArrayView(&Full, 1)));
+
+	TConstArrayView<uint8> Pixels = Heatmap->GetPixels();
+	TestEqual(TEXT("One byte per cell"), Pixels.Num(), Width * Height);
+	TestEqual(TEXT("Quantized value"), (int32)Pixels[5 * Width + 10], FMath::RoundToInt(0.25f * 255.0f));
+	TestEqual(TEXT("Ocean is zero"), (int32)Pixels[5 * Width + 30], 0);
+
+	// 没有变化时不上传
+	TestFalse(TEXT("Unchanged grid uploads nothing"), Heatmap->UpdateRegions(Grid, EHeatmapDataType::MantleEnergy, MakeArrayView(&Full, 1)));
+
+	// 区域之外的变化不会被看到
+	Grid.MantleEnergy[Grid.ToIndex(3, 3)] = 90.0f;
+	const FIntRect Elsewhere(10, 10, 20, 20);
+	TestFalse(TEXT("Change outside region ignored"), Heatmap->UpdateRegions(Grid, EHeatmapDataType::MantleEnergy, MakeArrayView(&Elsewhere, 1)));
+
+	const FIntRect Around(0, 0, 8, 8);
+	TestTrue(TEXT("Change inside region uploaded"), Heatmap->UpdateRegions(Grid, EHeatmapDataType::MantleEnergy, MakeArrayView(&Around, 1)));
+	TestEqual(TEXT("Changed pixel stored"), (int32)Heatmap->GetPixels()[3 * Width + 3], FMath::RoundToInt(0.9f * 255.0f));
+
+	return true;
+}
+
+// 测试：区域更新读取与整张更新相同的细节层级
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingHeatmapTextureRegionLodTest,
+	"EchoAlchemist.WorldMorphing.HeatmapTexture.RegionLod",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingHeatmapTextureRegionLodTest::RunTest(const FString& Parameters)
+{
+	FSimulationParams Params;
+	Params.RandomSeed = 404;
+
+	UWorldMorphingSubsystem* Subsystem = NewObject<UWorldMorphingSubsystem>();
+	Subsystem->InitializeWorld(64, 48, Params);
+
+	UWorldMorphingHeatmapTexture* Heatmap = UWorldMorphingHeatmapTexture::CreateHeatmapTexture(1, 1);
+	Heatmap->UpdateFromSubsystem(Subsystem, EHeatmapDataType::MantleEnergy, 1);
+	TestEqual(TEXT("LOD 1 texture size"), Heatmap->GetPixels().Num(), 32 * 24);
+
+	for (int32 Step = 0; Step < 10; ++Step)
+	{
+		Subsystem->TickSimulation(0.016f);
+	}
+
+	// 区域坐标是该层级的单元格，纹理不会被换成全分辨率
+	Heatmap->UpdateRegionFromSubsystem(Subsystem, EHeatmapDataType::MantleEnergy, 0, 0, 32, 24, 1);
+	TestEqual(TEXT("Region update keeps LOD size"), Heatmap->GetPixels().Num(), 32 * 24);
+
+	const TArray<uint8> RegionPixels(Heatmap->GetPixels());
+	TestFalse(TEXT("Region matches full LOD update"), Heatmap->UpdateFromSubsystem(Subsystem, EHeatmapDataType::MantleEnergy, 1));
+	TestTrue(TEXT("Pixels unchanged"), RegionPixels == Heatmap->GetPixels());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,117 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingKernels.h"
+
+// 测试：SIMD内核与标量规则一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingKernelsMatchScalarTest,
+	"EchoAlchemist.WorldMorphing.Kernels.MatchScalar",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingKernelsMatchScalarTest::RunTest(const FString& Parameters)
+{
+	// 宽度不是4的倍数，覆盖行尾的标量路径
+	const int32 Width = 23;
+	const int32 Height = 9;
+	const float Tolerance = 1e-4f;
+
+	FRandomStream Stream(7);
+	FWorldMorphingGrid Grid;
+	Grid.Init(Width, Height);
+
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const int32 Index = Grid.ToIndex(X, Y);
+			Grid.SetFlag(Index, EWorldCellFlags::Exists, Stream.FRand() < 0.75f);
+			Grid.MantleEnergy[Index] = Stream.FRandRange(0.0f, 150.0f);
+			Grid.Temperature[Index] = Stream.FRandRange(-50.0f, 50.0f);
+			Grid.TemperatureChange[Index] = Stream.FRandRange(-1.0f, 1.0f);
+			Grid.CrystalState[Index] = static_cast<ECrystalType>(Stream.RandRange(0, 3));
+		}
+	}
+
+	// 一个四周都不存在的单元格：温度变化量沿用上一步
+	const int32 Isolated = Grid.ToIndex(5, 4);
+	for (int32 i = 0; i < 8; ++i)
+	{
+		Grid.SetFlag(Isolated + Grid.NeighborOffsets[i], EWorldCellFlags::Exists, false);
+	}
+	Grid.SetFlag(Isolated, EWorldCellFlags::Exists, true);
+
+	TArray<float> ExistsMask;
+	ExistsMask.Init(0.0f, Grid.Num());
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		WorldMorphingKernels::BuildExistsMask(Grid.Flags.GetData(), ExistsMask.GetData(), Grid.ToIndex(0, Y), Width);
+	}
+
+	WorldMorphingKernels::FMantleExchangeParams ExchangeParams;
+	for (int32 i = 0; i < 8; ++i)
+	{
+		ExchangeParams.BiasFlow[i] = Stream.FRandRange(-0.1f, 0.1f);
+	}
+
+	WorldMorphingKernels::FTemperatureParams TemperatureParams;
+	TemperatureParams.SeasonalOffset = 3.0f;
+
+	TArray<float> VectorEnergy, ScalarEnergy;
+	VectorEnergy.Init(0.0f, Grid.Num());
+	ScalarEnergy.Init(0.0f, Grid.Num());
+
+	TArray<float> VectorTemperature, ScalarTemperature;
+	VectorTemperature.Init(0.0f, Grid.Num());
+	ScalarTemperature.Init(0.0f, Grid.Num());
+	TArray<float> VectorChange = Grid.TemperatureChange;
+	TArray<float> ScalarChange = Grid.TemperatureChange;
+
+	TArray<EWorldCellFlags> VectorFlags = Grid.Flags;
+	TArray<EWorldCellFlags> ScalarFlags = Grid.Flags;
+	const float Threshold = 30.0f;
+
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		const int32 RowStart = Grid.ToIndex(0, Y);
+		WorldMorphingKernels::MantleExchange(Grid.NeighborOffsets, ExistsMask.GetData(), Grid.MantleEnergy.GetData(), VectorEnergy.GetData(), ExchangeParams, RowStart, Width);
+		WorldMorphingKernels::MantleExchangeScalar(Grid.NeighborOffsets, ExistsMask.GetData(), Grid.MantleEnergy.GetData(), ScalarEnergy.GetData(), ExchangeParams, RowStart, Width);
+
+		WorldMorphingKernels::DiffuseTemperature(Grid.NeighborOffsets, ExistsMask.GetData(), Grid.MantleEnergy.GetData(), Grid.CrystalState.GetData(),
+			Grid.Temperature.GetData(), VectorChange.GetData(), VectorTemperature.GetData(), TemperatureParams, RowStart, Width);
+		WorldMorphingKernels::DiffuseTemperatureScalar(Grid.NeighborOffsets, ExistsMask.GetData(), Grid.MantleEnergy.GetData(), Grid.CrystalState.GetData(),
+			Grid.Temperature.GetData(), ScalarChange.GetData(), ScalarTemperature.GetData(), TemperatureParams, RowStart, Width);
+
+		WorldMorphingKernels::UpdateThunderstorms(Grid.NeighborOffsets, ExistsMask.GetData(), Grid.Temperature.GetData(),
+			Grid.Flags.GetData(), VectorFlags.GetData(), Threshold, RowStart, Width);
+		WorldMorphingKernels::UpdateThunderstormsScalar(Grid.NeighborOffsets, ExistsMask.GetData(), Grid.Temperature.GetData(),
+			Grid.Flags.GetData(), ScalarFlags.GetData(), Threshold, RowStart, Width);
+	}
+
+	int32 EnergyMismatches = 0;
+	int32 TemperatureMismatches = 0;
+	int32 FlagMismatches = 0;
+	int32 Storms = 0;
+	for (int32 Index = 0; Index < Grid.Num(); ++Index)
+	{
+		EnergyMismatches += FMath::IsNearlyEqual(VectorEnergy[Index], ScalarEnergy[Index], Tolerance) ? 0 : 1;
+		TemperatureMismatches += FMath::IsNearlyEqual(VectorTemperature[Index], ScalarTemperature[Index], Tolerance) ? 0 : 1;
+		TemperatureMismatches += FMath::IsNearlyEqual(VectorChange[Index], ScalarChange[Index], Tolerance) ? 0 : 1;
+		FlagMismatches += VectorFlags[Index] == ScalarFlags[Index] ? 0 : 1;
+		Storms += EnumHasAnyFlags(ScalarFlags[Index], EWorldCellFlags::Thunderstorm) ? 1 : 0;
+	}
+
+	TestEqual(TEXT("Mantle exchange matches scalar"), EnergyMismatches, 0);
+	TestEqual(TEXT("Temperature diffusion matches scalar"), TemperatureMismatches, 0);
+	TestEqual(TEXT("Thunderstorms match scalar"), FlagMismatches, 0);
+	TestTrue(TEXT("Threshold produces some storms"), Storms > 0);
+	TestEqual(TEXT("Isolated cell keeps its change"), VectorChange[Isolated],
+		Grid.TemperatureChange[Isolated] - (Grid.CrystalState[Isolated] == ECrystalType::Alpha ? 0.5f : Grid.CrystalState[Isolated] == ECrystalType::Beta ? 0.2f : 0.0f));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingLodGrid.h"
+
+// 测试：降采样聚合规则，以及没有地形的块在增量更新中被跳过
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingLodGridAggregateTest,
+	"EchoAlchemist.WorldMorphing.LodGrid.Aggregate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingLodGridAggregateTest::RunTest(const FString& Parameters)
+{
+	// 左边一列块（X < 16）有地形，其余为海洋；高度不是4的倍数
+	const int32 Width = 48;
+	const int32 Height = 30;
+
+	FWorldMorphingGrid Grid;
+	Grid.Init(Width, Height);
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < 16; ++X)
+		{
+			const int32 Index = Grid.ToIndex(X, Y);
+			Grid.SetFlag(Index, EWorldCellFlags::Exists, true);
+			Grid.MantleEnergy[Index] = static_cast<float>(X);
+		}
+	}
+
+	// 一个 2x2 块: 三个 Alpha、一个人类聚落
+	Grid.CrystalState[Grid.ToIndex(0, 0)] = ECrystalType::Alpha;
+	Grid.CrystalState[Grid.ToIndex(1, 0)] = ECrystalType::Alpha;
+	Grid.CrystalState[Grid.ToIndex(0, 1)] = ECrystalType::Alpha;
+	Grid.CrystalState[Grid.ToIndex(1, 1)] = ECrystalType::Human;
+	Grid.Prosperity[Grid.ToIndex(1, 1)] = 80.0f;
+
+	FWorldMorphingLodGrid Lod;
+	Lod.Init(Width, Height);
+	TestEqual(TEXT("All tiles built first"), Lod.Update(Grid), 3 * 2);
+
+	const FWorldMorphingGrid& Half = Lod.GetLevel(1);
+	const FWorldMorphingGrid& Quarter = Lod.GetLevel(2);
+	TestEqual(TEXT("LOD 1 width"), Half.Width, 24);
+	TestEqual(TEXT("LOD 2 height rounds up"), Quarter.Height, 8);
+
+	const int32 Corner = Half.ToIndex(0, 0);
+	TestTrue(TEXT("Land block exists"), Half.Exists(Corner));
+	TestTrue(TEXT("Majority crystal"), Half.CrystalState[Corner] == ECrystalType::Alpha);
+	TestEqual(TEXT("Max prosperity"), Half.Prosperity[Corner], 80.0f);
+	TestEqual(TEXT("Mean energy"), Half.MantleEnergy[Half.ToIndex(1, 0)], 2.5f);
+	TestEqual(TEXT("LOD 2 mean energy"), Quarter.MantleEnergy[Quarter.ToIndex(1, 3)], 5.5f);
+	TestFalse(TEXT("Ocean block"), Half.Exists(Half.ToIndex(12, 3)));
+
+	// 没有变化时只有含地形的块被重新聚合
+	TestEqual(TEXT("Ocean tiles skipped"), Lod.Update(Grid), 2);
+
+	// 海洋块中出现的地形在下一次更新中可见
+	const int32 Island = Grid.ToIndex(40, 20);
+	Grid.SetFlag(Island, EWorldCellFlags::Exists, true);
+	Grid.SetFlag(Grid.ToIndex(41, 20), EWorldCellFlags::Exists, true);
+	Grid.MantleEnergy[Island] = 60.0f;
+	TestEqual(TEXT("New land tile rebuilt"), Lod.Update(Grid), 3);
+	TestTrue(TEXT("Island visible"), Half.Exists(Half.ToIndex(20, 10)));
+	TestEqual(TEXT("Island energy"), Half.MantleEnergy[Half.ToIndex(20, 10)], 30.0f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
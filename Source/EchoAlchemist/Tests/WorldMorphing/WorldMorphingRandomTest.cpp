@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingRandom.h"
+#include "WorldMorphing/WorldMorphingSim.h"
+
+// 测试：计数器随机数只取决于输入，范围正确，不同键之间不相关
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingCellRandomTest,
+	"EchoAlchemist.WorldMorphing.Random.CounterBased",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingCellRandomTest::RunTest(const FString& Parameters)
+{
+	FWorldMorphingCellRandom A(17, 5, 2, 1234);
+	FWorldMorphingCellRandom B(17, 5, 2, 1234);
+	for (int32 Draw = 0; Draw < 8; ++Draw)
+	{
+		TestEqual(TEXT("Same inputs, same sequence"), A.Next(), B.Next());
+	}
+
+	// 相邻键、相邻时间步和不同阶段的首个值都不同
+	const uint64 First = FWorldMorphingCellRandom(17, 5, 2, 1234).Next();
+	TestNotEqual(TEXT("Neighbour key differs"), FWorldMorphingCellRandom(17, 5, 2, 1235).Next(), First);
+	TestNotEqual(TEXT("Next step differs"), FWorldMorphingCellRandom(17, 6, 2, 1234).Next(), First);
+	TestNotEqual(TEXT("Other stage differs"), FWorldMorphingCellRandom(17, 5, 3, 1234).Next(), First);
+
+	// 范围和大致均匀性
+	int32 Counts[3] = {};
+	double Sum = 0.0;
+	const int32 Samples = 30000;
+	for (int32 Key = 0; Key < Samples; ++Key)
+	{
+		FWorldMorphingCellRandom Random(1, 0, 1, Key);
+		const float Value = Random.FRand();
+		const int32 Range = Random.RandRange(0, 2);
+		if (Value < 0.0f || Value >= 1.0f || Range < 0 || Range > 2)
+		{
+			AddError(TEXT("Value out of range"));
+			break;
+		}
+		Sum += Value;
+		Counts[Range]++;
+	}
+	TestTrue(TEXT("Mean near 0.5"), FMath::Abs(Sum / Samples - 0.5) < 0.01);
+	for (int32 Count : Counts)
+	{
+		TestTrue(TEXT("Buckets near uniform"), FMath::Abs(Count - Samples / 3) < Samples / 30);
+	}
+
+	return true;
+}
+
+// 测试：同一种子的世界结果与是否多线程无关
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingCellRandomThreadingTest,
+	"EchoAlchemist.WorldMorphing.Random.IndependentOfThreading",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingCellRandomThreadingTest::RunTest(const FString& Parameters)
+{
+	FSimulationParams Params;
+	Params.RandomSeed = 909;
+
+	FWorldMorphingSim Sims[2];
+	for (int32 SimIndex = 0; SimIndex < 2; ++SimIndex)
+	{
+		Sims[SimIndex].SetUseMultithreading(SimIndex == 0);
+		Sims[SimIndex].Initialize(64, 64, Params);
+		for (int32 Step = 0; Step < 120; ++Step)
+		{
+			Sims[SimIndex].Step();
+		}
+	}
+
+	const FWorldMorphingGrid& Threaded = Sims[0].GetGrid();
+	const FWorldMorphingGrid& Serial = Sims[1].GetGrid();
+	TestTrue(TEXT("Flags match"), Threaded.Flags == Serial.Flags);
+	TestTrue(TEXT("Crystal state matches"), Threaded.CrystalState == Serial.CrystalState);
+	TestTrue(TEXT("Prosperity matches"), Threaded.Prosperity == Serial.Prosperity);
+	TestTrue(TEXT("Mantle energy matches"), Threaded.MantleEnergy == Serial.MantleEnergy);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
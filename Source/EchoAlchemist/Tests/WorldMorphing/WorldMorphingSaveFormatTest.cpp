@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingSubsystem.h"
+#include "WorldMorphing/WorldMorphingSaveFormat.h"
+#include "Serialization/MemoryWriter.h"
+
+// 测试：完整存档和增量存档往返，增量必须基于同一关键帧
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingSaveFormatRoundTripTest,
+	"EchoAlchemist.WorldMorphing.SaveFormat.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingSaveFormatRoundTripTest::RunTest(const FString& Parameters)
+{
+	FSimulationParams Params;
+	Params.RandomSeed = 4321;
+
+	const int32 Size = 96;
+
+	UWorldMorphingSubsystem* Source = NewObject<UWorldMorphingSubsystem>();
+	Source->InitializeWorld(Size, Size, Params);
+	for (int32 Step = 0; Step < 50; ++Step)
+	{
+		Source->TickSimulation(0.016f);
+	}
+
+	TArray<uint8> Keyframe;
+	TestTrue(TEXT("Full save"), Source->SaveWorldSnapshot(Keyframe));
+
+	for (int32 Step = 0; Step < 5; ++Step)
+	{
+		Source->TickSimulation(0.016f);
+	}
+
+	TArray<uint8> Delta;
+	TestTrue(TEXT("Delta save"), Source->SaveWorldSnapshot(Delta, true));
+	TestTrue(TEXT("Full save is well below raw float planes"), Keyframe.Num() < Size * Size * 8 * (int32)sizeof(float) / 2);
+	TestTrue(TEXT("Delta smaller than keyframe"), Delta.Num() < Keyframe.Num());
+
+	// 没有关键帧时增量存档无法加载
+	UWorldMorphingSubsystem* Target = NewObject<UWorldMorphingSubsystem>();
+	AddExpectedError(TEXT("does not match the current keyframe"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Delta rejected without keyframe"), Target->LoadWorldSnapshot(Delta));
+
+	TestTrue(TEXT("Load keyframe"), Target->LoadWorldSnapshot(Keyframe));
+	TestTrue(TEXT("Load delta"), Target->LoadWorldSnapshot(Delta));
+	TestEqual(TEXT("Time step restored"), Target->GetTimeStep(), Source->GetTimeStep());
+	TestEqual(TEXT("Seed restored"), Target->GetRandomSeed(), Source->GetRandomSeed());
+
+	// 浮点字段按半精度量化（相对误差 < 1/1024）
+	int32 Mismatches = 0;
+	for (int32 Y = 0; Y < Size; ++Y)
+	{
+		for (int32 X = 0; X < Size; ++X)
+		{
+			const FCellState A = Source->GetCellAt(X, Y);
+			const FCellState B = Target->GetCellAt(X, Y);
+			if (A.bExists != B.bExists
+				|| A.CrystalType != B.CrystalType
+				|| A.bHasThunderstorm != B.bHasThunderstorm
+				|| !FMath::IsNearlyEqual(A.MantleEnergy, B.MantleEnergy, FMath::Abs(A.MantleEnergy) / 1024.0f + 1e-4f)
+				|| !FMath::IsNearlyEqual(A.Temperature, B.Temperature, FMath::Abs(A.Temperature) / 1024.0f + 1e-4f)
+				|| !FMath::IsNearlyEqual(A.Prosperity, B.Prosperity, FMath::Abs(A.Prosperity) / 1024.0f + 1e-4f))
+			{
+				Mismatches++;
+			}
+		}
+	}
+	TestEqual(TEXT("Cells restored"), Mismatches, 0);
+
+	// 加载后的世界可以继续模拟
+	Target->TickSimulation(0.016f);
+	TestEqual(TEXT("Simulation resumes"), Target->GetTimeStep(), Source->GetTimeStep() + 1);
+
+	return true;
+}
+
+// 测试：平面字节数超过 int32 范围的存档头被拒绝，不会因溢出通过大小检查
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingSaveFormatOversizeTest,
+	"EchoAlchemist.WorldMorphing.SaveFormat.Oversize",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingSaveFormatOversizeTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("Small plane size"), FWorldMorphingSaveFormat::GetPlaneSize(4, 3), 4 * 3 * FWorldMorphingSaveFormat::BytesPerCell);
+	TestEqual(TEXT("Oversize rejected"), FWorldMorphingSaveFormat::GetPlaneSize(16384, 16384), static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Empty rejected"), FWorldMorphingSaveFormat::GetPlaneSize(0, 16), static_cast<int32>(INDEX_NONE));
+
+	// 16384 x 16384 的存档头，平面大小填入32位回绕后的值
+	const int32 Dimension = 16384;
+	const int32 WrappedPlaneSize = static_cast<int32>(static_cast<uint32>(static_cast<uint64>(Dimension) * Dimension * FWorldMorphingSaveFormat::BytesPerCell));
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	uint32 Magic = FWorldMorphingSaveFormat::Magic;
+	int32 Version = FWorldMorphingSaveFormat::Version;
+	int32 Width = Dimension;
+	int32 Height = Dimension;
+	bool bDelta = false;
+	int32 Zero = 0;
+	float NoiseOffset = 0.0f;
+	uint32 KeyframeCrc = 0;
+	uint8 Codec = 0;
+	int32 PlaneSize = WrappedPlaneSize;
+	int32 CompressedSize = 0;
+	Writer << Magic << Version << Width << Height << bDelta;
+	Writer << Zero << Zero << Zero << Zero;
+	Writer << NoiseOffset << NoiseOffset;
+	Writer << Zero;
+	Writer << KeyframeCrc << Codec << PlaneSize << CompressedSize;
+
+	FWorldMorphingSaveHeader Header;
+	TArray<uint8> Planes;
+	AddExpectedError(TEXT("corrupt header"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Oversize header rejected"), FWorldMorphingSaveFormat::Load(Data, TConstArrayView<uint8>(), Header, Planes));
+	TestEqual(TEXT("Nothing allocated"), Planes.Num(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,205 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingSim.h"
+#include "WorldMorphing/WorldMorphingSubsystem.h"
+#include "WorldMorphing/WorldMorphingSaveFormat.h"
+#include "Async/ParallelFor.h"
+
+// 测试：独立引擎与子系统结果逐位一致，多个世界并行推进互不影响
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingSimMatchesSubsystemTest,
+	"EchoAlchemist.WorldMorphing.Sim.MatchesSubsystem",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingSimMatchesSubsystemTest::RunTest(const FString& Parameters)
+{
+	FSimulationParams Params;
+	Params.RandomSeed = 4321;
+
+	const int32 Size = 48;
+	const int32 Steps = 150;
+
+	UWorldMorphingSubsystem* Subsystem = NewObject<UWorldMorphingSubsystem>();
+	Subsystem->InitializeWorld(Size, Size, Params);
+	for (int32 Step = 0; Step < Steps; ++Step)
+	{
+		Subsystem->TickSimulation(0.016f);
+	}
+
+	// 两个相同种子的世界同时在不同线程上推进
+	FWorldMorphingSim Sims[2];
+	ParallelFor(2, [&](int32 SimIndex)
+	{
+		Sims[SimIndex].SetUseMultithreading(false);
+		Sims[SimIndex].Initialize(Size, Size, Params);
+		for (int32 Step = 0; Step < Steps; ++Step)
+		{
+			Sims[SimIndex].Step();
+		}
+	});
+
+	const FWorldMorphingGrid& Expected = Subsystem->GetReadGrid();
+	for (const FWorldMorphingSim& Sim : Sims)
+	{
+		const FWorldMorphingGrid& Actual = Sim.GetGrid();
+		TestEqual(TEXT("Time step"), Sim.GetTimeStep(), Subsystem->GetTimeStep());
+		TestTrue(TEXT("Flags match"), Actual.Flags == Expected.Flags);
+		TestTrue(TEXT("Crystal state matches"), Actual.CrystalState == Expected.CrystalState);
+		for (int32 Field = 0; Field < static_cast<int32>(EWorldMorphingField::Count); ++Field)
+		{
+			const EWorldMorphingField FieldType = static_cast<EWorldMorphingField>(Field);
+			TestTrue(FString::Printf(TEXT("Field %d matches"), Field), Actual.GetField(FieldType) == Expected.GetField(FieldType));
+		}
+		TestEqual(TEXT("Statistics match"), Sim.GetStatistics().TerrainCells, Subsystem->GetStatistics().TerrainCells);
+	}
+
+	return true;
+}
+
+// 测试：扩张受 MaxRadius 限制，参数中的半径改变后径向掩码随之重建
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingSimRadialLimitTest,
+	"EchoAlchemist.WorldMorphing.Sim.RadialLimit",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingSimRadialLimitTest::RunTest(const FString& Parameters)
+{
+	// 40x40 的初始陆地半径为16，扩张阈值很低，边缘每步都会尝试扩张
+	const int32 Size = 40;
+	FSimulationParams Params;
+	Params.RandomSeed = 55;
+	Params.ExpansionThreshold = 1.0f;
+	Params.ShrinkThreshold = 0.0f;
+	Params.MaxRadius = 18.0f;
+
+	FWorldMorphingSim Sim;
+	Sim.Initialize(Size, Size, Params);
+
+	auto MaxLandRadius = [&Sim, Size]()
+	{
+		const FWorldMorphingGrid& Grid = Sim.GetGrid();
+		float MaxRadius = 0.0f;
+		for (int32 Y = 0; Y < Size; ++Y)
+		{
+			for (int32 X = 0; X < Size; ++X)
+			{
+				if (Grid.Exists(Grid.ToIndex(X, Y)))
+				{
+					MaxRadius = FMath::Max(MaxRadius, FMath::Sqrt(FMath::Square(X - Size / 2.0f) + FMath::Square(Y - Size / 2.0f)));
+				}
+			}
+		}
+		return MaxRadius;
+	};
+
+	for (int32 Step = 0; Step < 30; ++Step)
+	{
+		Sim.Step();
+	}
+	TestTrue(TEXT("Land expanded"), MaxLandRadius() > 16.0f);
+	TestTrue(TEXT("Land within MaxRadius"), MaxLandRadius() <= 18.0f);
+
+	Params.MaxRadius = 22.0f;
+	Sim.SetParams(Params);
+	for (int32 Step = 0; Step < 60; ++Step)
+	{
+		Sim.Step();
+	}
+	TestTrue(TEXT("Land follows new MaxRadius"), MaxLandRadius() > 18.0f);
+	TestTrue(TEXT("Land within new MaxRadius"), MaxLandRadius() <= 22.0f);
+
+	return true;
+}
+
+// 测试：两个聚落迁往同一单元格时繁荣度高者胜出，相同时槽位小者胜出，与是否多线程无关
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingSimHumanGatherTest,
+	"EchoAlchemist.WorldMorphing.Sim.HumanGather",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingSimHumanGatherTest::RunTest(const FString& Parameters)
+{
+	// 地幔、气候和晶石层不改变晶石状态；人类繁荣度不增不减，聚落都想迁移
+	const int32 Size = 48;
+	FSimulationParams Params;
+	Params.RandomSeed = 31;
+	Params.ExpansionThreshold = 1.0e6f;
+	Params.ShrinkThreshold = -1.0e6f;
+	Params.EdgeGenerationEnergy = 0.0f;
+	Params.HumanMinTemp = -1000.0f;
+	Params.HumanMaxTemp = 1000.0f;
+	Params.HumanSurvivalMinTemp = -1000.0f;
+	Params.HumanSurvivalMaxTemp = 1000.0f;
+	Params.HumanProsperityGrowth = 0.0f;
+	Params.HumanProsperityDecay = 0.0f;
+	Params.HumanExpansionThreshold = 1000.0f;
+	Params.HumanMigrationThreshold = 40.0f;
+
+	// 每组三个单元格成一条线，只有它们存在：两端是聚落，中间是唯一的迁移目标
+	// 横向一组繁荣度不同；纵向一组繁荣度相同，并且跨越条带边界（第16行是第二个条带的首行）
+	FWorldMorphingGrid Grid;
+	Grid.Init(Size, Size);
+	auto PlaceSettlement = [&Grid](int32 X, int32 Y, float Prosperity)
+	{
+		const int32 Index = Grid.ToIndex(X, Y);
+		Grid.SetFlag(Index, EWorldCellFlags::Exists, true);
+		Grid.CrystalState[Index] = ECrystalType::Human;
+		Grid.Prosperity[Index] = Prosperity;
+	};
+	PlaceSettlement(10, 5, 20.0f);
+	PlaceSettlement(12, 5, 30.0f);
+	Grid.SetFlag(Grid.ToIndex(11, 5), EWorldCellFlags::Exists, true);
+	PlaceSettlement(30, 15, 25.0f);
+	PlaceSettlement(30, 17, 25.0f);
+	Grid.SetFlag(Grid.ToIndex(30, 16), EWorldCellFlags::Exists, true);
+
+	FWorldMorphingSaveHeader Header;
+	Header.Width = Size;
+	Header.Height = Size;
+	Header.Seed = Params.RandomSeed;
+
+	FWorldMorphingSim Sims[2];
+	for (int32 SimIndex = 0; SimIndex < 2; ++SimIndex)
+	{
+		FWorldMorphingGrid Start = Grid;
+		Sims[SimIndex].SetUseMultithreading(SimIndex == 0);
+		Sims[SimIndex].Initialize(Size, Size, Params);
+		Sims[SimIndex].RestoreState(Header, MoveTemp(Start));
+		Sims[SimIndex].Step();
+	}
+
+	const FWorldMorphingGrid& Result = Sims[0].GetGrid();
+	auto IsHuman = [&Result](int32 X, int32 Y)
+	{
+		return Result.CrystalState[Result.ToIndex(X, Y)] == ECrystalType::Human;
+	};
+	auto ProsperityAt = [&Result](int32 X, int32 Y)
+	{
+		return Result.Prosperity[Result.ToIndex(X, Y)];
+	};
+
+	// 繁荣度高者（右侧）迁入，带来八成繁荣度；落选者原地不动
+	TestTrue(TEXT("Target settled"), IsHuman(11, 5));
+	TestEqual(TEXT("Winner brings 80% prosperity"), ProsperityAt(11, 5), 24.0f);
+	TestFalse(TEXT("Higher prosperity moved out"), IsHuman(12, 5));
+	TestTrue(TEXT("Lower prosperity stays"), IsHuman(10, 5));
+	TestEqual(TEXT("Loser prosperity unchanged"), ProsperityAt(10, 5), 20.0f);
+
+	// 繁荣度相同时槽位小者（上方）胜出
+	TestTrue(TEXT("Tie target settled"), IsHuman(30, 16));
+	TestEqual(TEXT("Tie winner prosperity"), ProsperityAt(30, 16), 20.0f);
+	TestFalse(TEXT("Lower slot moved out"), IsHuman(30, 15));
+	TestTrue(TEXT("Higher slot stays"), IsHuman(30, 17));
+
+	TestEqual(TEXT("Human count unchanged"), Sims[0].GetStatistics().HumanSettlements, 4);
+
+	const FWorldMorphingGrid& Serial = Sims[1].GetGrid();
+	TestTrue(TEXT("Crystal state matches serial"), Result.CrystalState == Serial.CrystalState);
+	TestTrue(TEXT("Prosperity matches serial"), Result.Prosperity == Serial.Prosperity);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingSnapshot.h"
+
+// 测试：三缓冲发布与获取
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingSnapshotTripleBufferTest,
+	"EchoAlchemist.WorldMorphing.Snapshot.TripleBuffer",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingSnapshotTripleBufferTest::RunTest(const FString& Parameters)
+{
+	FWorldMorphingSnapshotBuffer Buffer;
+	Buffer.Reset();
+
+	// 尚未发布时读取端拿到空快照
+	TestEqual(TEXT("Nothing published"), Buffer.AcquireLatest().Version, static_cast<uint64>(0));
+
+	Buffer.GetWriteBuffer().TimeStep = 1;
+	Buffer.Publish();
+
+	const FWorldMorphingSnapshot& First = Buffer.AcquireLatest();
+	TestEqual(TEXT("First version"), First.Version, static_cast<uint64>(1));
+	TestEqual(TEXT("First time step"), First.TimeStep, 1);
+
+	// 读取端持有的快照在下一次获取前不被写入端覆盖
+	for (int32 Step = 2; Step <= 5; ++Step)
+	{
+		Buffer.GetWriteBuffer().TimeStep = Step;
+		Buffer.Publish();
+		TestEqual(TEXT("Held snapshot unchanged"), Buffer.GetReadBuffer().TimeStep, 1);
+	}
+
+	// 获取时跳过中间版本，直接拿到最新一份
+	const FWorldMorphingSnapshot& Latest = Buffer.AcquireLatest();
+	TestEqual(TEXT("Latest version"), Latest.Version, static_cast<uint64>(5));
+	TestEqual(TEXT("Latest time step"), Latest.TimeStep, 5);
+
+	// 没有新发布时保持当前快照
+	TestEqual(TEXT("No new snapshot"), Buffer.AcquireLatest().Version, static_cast<uint64>(5));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
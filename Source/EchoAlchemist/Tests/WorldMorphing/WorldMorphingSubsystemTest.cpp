@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingSubsystem.h"
+
+// 测试：相同种子下多线程与单线程结果逐位一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingDeterminismTest,
+	"EchoAlchemist.WorldMorphing.Subsystem.Determinism",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingDeterminismTest::RunTest(const FString& Parameters)
+{
+	FSimulationParams Params;
+	Params.RandomSeed = 1234;
+
+	// 50行 = 4个条带（最后一个不完整）
+	const int32 Size = 50;
+	const int32 Steps = 200;
+
+	UWorldMorphingSubsystem* Parallel = NewObject<UWorldMorphingSubsystem>();
+	UWorldMorphingSubsystem* Serial = NewObject<UWorldMorphingSubsystem>();
+	Serial->SetUseMultithreading(false);
+
+	Parallel->InitializeWorld(Size, Size, Params);
+	Serial->InitializeWorld(Size, Size, Params);
+
+	for (int32 Step = 0; Step < Steps; ++Step)
+	{
+		Parallel->TickSimulation(0.016f);
+		Serial->TickSimulation(0.016f);
+	}
+
+	int32 Mismatches = 0;
+	int32 ExistingCells = 0;
+	for (int32 Y = 0; Y < Size; ++Y)
+	{
+		for (int32 X = 0; X < Size; ++X)
+		{
+			const FCellState A = Parallel->GetCellAt(X, Y);
+			const FCellState B = Serial->GetCellAt(X, Y);
+
+			ExistingCells += A.bExists ? 1 : 0;
+			if (A.bExists != B.bExists
+				|| A.CrystalType != B.CrystalType
+				|| A.bHasThunderstorm != B.bHasThunderstorm
+				|| A.bIsAbsorbing != B.bIsAbsorbing
+				|| A.MantleEnergy != B.MantleEnergy
+				|| A.Temperature != B.Temperature
+				|| A.StoredEnergy != B.StoredEnergy
+				|| A.Prosperity != B.Prosperity)
+			{
+				Mismatches++;
+			}
+		}
+	}
+
+	TestTrue(TEXT("World has terrain"), ExistingCells > 0);
+	TestEqual(TEXT("Bit-identical cells"), Mismatches, 0);
+
+	return true;
+}
+
+// 测试：增量维护的统计与全量重新计算一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingStatisticsTest,
+	"EchoAlchemist.WorldMorphing.Subsystem.Statistics",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingStatisticsTest::RunTest(const FString& Parameters)
+{
+	FSimulationParams Params;
+	Params.RandomSeed = 99;
+
+	UWorldMorphingSubsystem* Subsystem = NewObject<UWorldMorphingSubsystem>();
+	Subsystem->InitializeWorld(64, 64, Params);
+
+	// 停在两次全量重新计算之间
+	for (int32 Step = 0; Step < 200; ++Step)
+	{
+		Subsystem->TickSimulation(0.016f);
+	}
+
+	FWorldMorphingStatistics Exact;
+	Exact.Recompute(Subsystem->GetReadGrid());
+	const FWorldStatistics Expected = Exact.ToStatistics();
+	const FWorldStatistics Actual = Subsystem->GetStatistics();
+
+	TestTrue(TEXT("World has terrain"), Expected.TerrainCells > 0);
+	TestTrue(TEXT("World has crystals"), Expected.AlphaCrystals + Expected.BetaCrystals > 0);
+	TestEqual(TEXT("Total cells"), Actual.TotalCells, Expected.TotalCells);
+	TestEqual(TEXT("Terrain cells"), Actual.TerrainCells, Expected.TerrainCells);
+	TestEqual(TEXT("Alpha crystals"), Actual.AlphaCrystals, Expected.AlphaCrystals);
+	TestEqual(TEXT("Beta crystals"), Actual.BetaCrystals, Expected.BetaCrystals);
+	TestEqual(TEXT("Human settlements"), Actual.HumanSettlements, Expected.HumanSettlements);
+	TestEqual(TEXT("Thunderstorm cells"), Actual.ThunderstormCells, Expected.ThunderstormCells);
+	TestEqual(TEXT("Average mantle energy"), Actual.AverageMantleEnergy, Expected.AverageMantleEnergy, 1e-3f);
+	TestEqual(TEXT("Average temperature"), Actual.AverageTemperature, Expected.AverageTemperature, 1e-3f);
+
+	return true;
+}
+
+// 测试：时间加速按 DeltaTime 推进多步，小数部分留到下一帧
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingTimeWarpTest,
+	"EchoAlchemist.WorldMorphing.Subsystem.TimeWarp",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingTimeWarpTest::RunTest(const FString& Parameters)
+{
+	FSimulationParams Params;
+	Params.RandomSeed = 7;
+
+	UWorldMorphingSubsystem* Subsystem = NewObject<UWorldMorphingSubsystem>();
+	Subsystem->InitializeWorld(32, 32, Params);
+
+	// 不限预算: 100 步/秒 * 0.125 秒 = 12.5 步
+	Subsystem->SetTimeWarp(100.0f, 0.0f);
+	Subsystem->TickSimulation(0.125f);
+	TestEqual(TEXT("Whole steps advanced"), Subsystem->GetTimeStep(), 12);
+	TestEqual(TEXT("Fraction carried"), Subsystem->GetTimeWarpBacklog(), 0.5f);
+
+	Subsystem->TickSimulation(0.125f);
+	TestEqual(TEXT("Carry completes a step"), Subsystem->GetTimeStep(), 25);
+	TestEqual(TEXT("Backlog drained"), Subsystem->GetTimeWarpBacklog(), 0.0f);
+
+	// 关闭后回到每次调用一步
+	Subsystem->SetTimeWarp(0.0f);
+	Subsystem->TickSimulation(0.125f);
+	TestEqual(TEXT("One step per tick"), Subsystem->GetTimeStep(), 26);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
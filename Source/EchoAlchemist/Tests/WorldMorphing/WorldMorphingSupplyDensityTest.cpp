@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingSupplyDensity.h"
+
+// 测试：查表密度与逐点计算一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingSupplyDensityLookupTest,
+	"EchoAlchemist.WorldMorphing.SupplyDensity.Lookup",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingSupplyDensityLookupTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Stream(99);
+
+	// 包含跨越 0/2π 的供给点
+	TArray<FEdgeSupplyPoint> Points;
+	Points.Add(FEdgeSupplyPoint(0.02f, 0.0f));
+	Points.Add(FEdgeSupplyPoint(2.0f * PI - 0.01f, 0.0f));
+	for (int32 i = 0; i < 4; ++i)
+	{
+		Points.Add(FEdgeSupplyPoint(Stream.FRand() * 2.0f * PI, 0.0f));
+	}
+
+	FWorldMorphingSupplyDensity Density;
+
+	// 默认宽度 (2 * 0.15) 和较窄的宽度
+	for (const float Sigma : { 0.3f, 0.15f })
+	{
+		Density.Build(Points, Sigma);
+
+		float MaxError = 0.0f;
+		for (int32 Sample = 0; Sample < 2000; ++Sample)
+		{
+			const float Angle = Stream.FRand() * 2.0f * PI;
+			MaxError = FMath::Max(MaxError, FMath::Abs(Density.Sample(Angle) - FWorldMorphingSupplyDensity::Evaluate(Points, Sigma, Angle)));
+		}
+
+		TestTrue(FString::Printf(TEXT("Lookup error %.5f within tolerance (sigma %.2f)"), MaxError, Sigma), MaxError < 2e-3f);
+	}
+
+	// 供给点正上方的密度至少为1
+	TestTrue(TEXT("Peak at supply point"), Density.Sample(0.02f) >= 1.0f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
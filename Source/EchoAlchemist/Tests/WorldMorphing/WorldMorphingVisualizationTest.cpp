@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "WorldMorphing/WorldMorphingVisualization.h"
+#include "WorldMorphing/WorldMorphingSubsystem.h"
+
+namespace
+{
+	/** 原有的逐单元格热力图规则（经 GetCellAt 读取） */
+	float ReferenceHeatmapValue(const FCellState& Cell, EHeatmapDataType DataType)
+	{
+		switch (DataType)
+		{
+		case EHeatmapDataType::MantleEnergy:
+			return FMath::Clamp(Cell.bExists ? Cell.MantleEnergy / 100.0f : 0.0f, 0.0f, 1.0f);
+		case EHeatmapDataType::Temperature:
+			return FMath::Clamp(Cell.bExists ? (Cell.Temperature + 50.0f) / 100.0f : 0.0f, 0.0f, 1.0f);
+		case EHeatmapDataType::CrystalDensity:
+			return Cell.CrystalType != ECrystalType::Empty ? 1.0f : 0.0f;
+		case EHeatmapDataType::HumanDensity:
+			return FMath::Clamp(Cell.Prosperity / 100.0f, 0.0f, 1.0f);
+		default:
+			return 0.0f;
+		}
+	}
+}
+
+// 测试：写入调用方缓冲的热力图与逐单元格读取一致，错误大小的缓冲被拒绝
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldMorphingVisualizationWriteHeatmapTest,
+	"EchoAlchemist.WorldMorphing.Visualization.WriteHeatmap",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWorldMorphingVisualizationWriteHeatmapTest::RunTest(const FString& Parameters)
+{
+	const int32 Width = 52;
+	const int32 Height = 37;
+
+	FSimulationParams Params;
+	Params.RandomSeed = 812;
+
+	UWorldMorphingSubsystem* Subsystem = NewObject<UWorldMorphingSubsystem>();
+	Subsystem->InitializeWorld(Width, Height, Params);
+	for (int32 Step = 0; Step < 80; ++Step)
+	{
+		Subsystem->TickSimulation(0.016f);
+	}
+
+	const EHeatmapDataType Types[] =
+	{
+		EHeatmapDataType::MantleEnergy,
+		EHeatmapDataType::Temperature,
+		EHeatmapDataType::CrystalDensity,
+		EHeatmapDataType::HumanDensity,
+	};
+
+	TArray<float> Heatmap;
+	Heatmap.SetNumUninitialized(Width * Height);
+	for (EHeatmapDataType DataType : Types)
+	{
+		TestTrue(TEXT("Heatmap written"), UWorldMorphingVisualization::WriteSubsystemHeatmapData(Subsystem, DataType, Heatmap));
+
+		int32 Mismatches = 0;
+		for (int32 Y = 0; Y < Height; ++Y)
+		{
+			for (int32 X = 0; X < Width; ++X)
+			{
+				Mismatches += Heatmap[Y * Width + X] != ReferenceHeatmapValue(Subsystem->GetCellAt(X, Y), DataType) ? 1 : 0;
+			}
+		}
+		TestEqual(FString::Printf(TEXT("Type %d matches per-cell path"), static_cast<int32>(DataType)), Mismatches, 0);
+	}
+
+	// 字段视图与单元格读取指向同一份数据
+	const FWorldMorphingGrid& Grid = Subsystem->GetReadGrid();
+	TConstArrayView<float> Energy = Subsystem->GetFieldView(EWorldMorphingField::MantleEnergy);
+	TConstArrayView<ECrystalType> Crystals = Subsystem->GetCrystalStateView();
+	TestEqual(TEXT("Field view covers halo"), Energy.Num(), Grid.Num());
+	TestEqual(TEXT("Field view value"), Energy[Grid.ToIndex(20, 15)], Subsystem->GetCellAt(20, 15).MantleEnergy);
+	TestTrue(TEXT("Crystal view value"), Crystals[Grid.ToIndex(Width / 2, Height / 2)] == Subsystem->GetCellAt(Width / 2, Height / 2).CrystalType);
+
+	// 活跃度直接写入缓冲，与分配版本一致
+	TestTrue(TEXT("Activity written"), UWorldMorphingVisualization::WriteSubsystemHeatmapData(Subsystem, EHeatmapDataType::Activity, Heatmap));
+	TestTrue(TEXT("Activity matches"), Heatmap == Subsystem->GetActivityHeatmap());
+
+	// 大小不符的缓冲被拒绝，内容不变
+	TArray<float> Wrong;
+	Wrong.Init(-1.0f, Width * Height - 1);
+	TestFalse(TEXT("Short buffer rejected"), UWorldMorphingVisualization::WriteSubsystemHeatmapData(Subsystem, EHeatmapDataType::MantleEnergy, Wrong));
+	TestFalse(TEXT("Short activity buffer rejected"), UWorldMorphingVisualization::WriteSubsystemHeatmapData(Subsystem, EHeatmapDataType::Activity, Wrong));
+	TestEqual(TEXT("Rejected buffer untouched"), Wrong[0], -1.0f);
+	TestFalse(TEXT("LOD buffer size enforced"), UWorldMorphingVisualization::WriteSubsystemHeatmapData(Subsystem, EHeatmapDataType::MantleEnergy, Heatmap, 1));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS